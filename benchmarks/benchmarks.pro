@@ -0,0 +1,35 @@
+QT      += core gui dbus widgets x11extras svg concurrent testlib
+
+TARGET = launcher-benchmark
+TEMPLATE = app
+CONFIG += c++11 link_pkgconfig fake_daemon
+PKGCONFIG += dtkbase dtkwidget dtkutil xcb xcb-ewmh\
+          gsettings-qt gtk+-2.0 gio-unix-2.0 dframeworkdbus
+
+ROOT = $$PWD/..
+
+# fakes shadow real daemon interfaces included by model
+INCLUDEPATH += $$PWD/fakedbus
+INCLUDEPATH += $$ROOT
+
+include($$ROOT/feature-macros.pri)
+include($$ROOT/dbusinterface/dbusinterface.pri)
+include($$ROOT/global_util/global_util.pri)
+include($$ROOT/model/model.pri)
+include($$ROOT/delegate/delegate.pri)
+
+HEADERS += \
+    $$PWD/fakedbus/fakereply.h \
+    $$PWD/fakedbus/dbuslauncher.h \
+    $$PWD/fakedbus/dbustartmanager.h \
+    $$PWD/fakedbus/dbusdock.h \
+    $$PWD/launcherbenchmark.h
+
+SOURCES += \
+    $$PWD/fakedbus/dbuslauncher.cpp \
+    $$PWD/fakedbus/dbustartmanager.cpp \
+    $$PWD/fakedbus/dbusdock.cpp \
+    $$PWD/launcherbenchmark.cpp
+
+RESOURCES += \
+    $$ROOT/skin.qrc
@@ -0,0 +1,6 @@
+#include "dbusdock.h"
+
+DBusDock::DBusDock(QObject *parent) :
+    QObject(parent)
+{
+}
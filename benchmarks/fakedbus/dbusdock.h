@@ -0,0 +1,32 @@
+#ifndef DBUSDOCK_H
+#define DBUSDOCK_H
+
+#include "fakereply.h"
+
+#include <QObject>
+
+///
+/// \brief The DBusDock class is an in-process fake of dock daemon
+///
+/// docked apps are read as D-Bus property through connection(), which is never
+/// connected, so no app is docked.
+///
+class DBusDock : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DBusDock(QObject *parent = 0);
+
+    inline QString service() const {return "com.deepin.dde.daemon.Dock";}
+    inline QString path() const {return "/com/deepin/dde/daemon/Dock";}
+    inline QString interface() const {return "com.deepin.dde.daemon.Dock";}
+    inline QDBusConnection connection() const {return QDBusConnection("fake-dock");}
+    inline int position() const {return 2;}
+
+Q_SIGNALS: // SIGNALS
+    void PositionChanged();
+    void DockedAppsChanged();
+};
+
+#endif // DBUSDOCK_H
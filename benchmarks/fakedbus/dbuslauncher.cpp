@@ -0,0 +1,78 @@
+#include "dbuslauncher.h"
+
+ItemInfoList DBusLauncher::Apps;
+
+DBusLauncher::DBusLauncher(QObject *parent) :
+    QObject(parent)
+{
+    ItemInfo::registerMetaType();
+}
+
+void DBusLauncher::setApps(const ItemInfoList &apps)
+{
+    Apps = apps;
+}
+
+///
+/// \brief DBusLauncher::syntheticApps generate apps with names and categories spread like a real system
+///
+const ItemInfoList DBusLauncher::syntheticApps(const int count)
+{
+    static const QStringList words = {"Deepin", "Music", "Video", "Office", "Text", "Editor", "Web", "Browser",
+                                      "Image", "Viewer", "System", "Monitor", "Terminal", "Mail", "Game", "Player"};
+    static const QStringList icons = {"application-x-executable", "utilities-terminal", "accessories-text-editor",
+                                      "internet-web-browser", "multimedia-video-player", "applications-games"};
+
+    ItemInfoList apps;
+    apps.reserve(count);
+    for (int i(0); i != count; ++i)
+    {
+        ItemInfo info;
+        info.m_key = QString("synthetic-app-%1").arg(i);
+        info.m_name = QString("%1 %2 %3").arg(words[i % words.size()]).arg(words[i / words.size() % words.size()]).arg(i);
+        info.m_desktop = QString("/usr/share/applications/%1.desktop").arg(info.m_key);
+        info.m_iconKey = icons[i % icons.size()];
+        info.m_categoryId = i % 11;
+        info.m_installedTime = i;
+
+        apps.append(info);
+    }
+
+    return apps;
+}
+
+FakeReply<ItemInfoList> DBusLauncher::GetAllItemInfos()
+{
+    return Apps;
+}
+
+FakeReply<QStringList> DBusLauncher::GetAllNewInstalledApps()
+{
+    return QStringList();
+}
+
+FakeReply<> DBusLauncher::MarkLaunched(const QString &in0)
+{
+    Q_UNUSED(in0)
+
+    return FakeReply<>();
+}
+
+FakeReply<> DBusLauncher::RequestUninstall(const QString &in0, bool in1)
+{
+    Q_UNUSED(in1)
+
+    emit UninstallSuccess(in0);
+
+    return FakeReply<>();
+}
+
+FakeReply<> DBusLauncher::Search(const QString &in0)
+{
+    Q_UNUSED(in0)
+
+    // fake daemon knows no pinyin, nothing is added to local results
+    emit SearchDone(QStringList());
+
+    return FakeReply<>();
+}
@@ -0,0 +1,41 @@
+#ifndef DBUSLAUNCHER_H
+#define DBUSLAUNCHER_H
+
+#include "fakereply.h"
+#include "dbusvariant/iteminfo.h"
+
+#include <QObject>
+#include <QStringList>
+
+///
+/// \brief The DBusLauncher class is an in-process fake of launcher daemon, apps are set by benchmarks
+///
+class DBusLauncher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DBusLauncher(QObject *parent = 0);
+
+    static void setApps(const ItemInfoList &apps);
+    static const ItemInfoList syntheticApps(const int count);
+
+public Q_SLOTS: // METHODS
+    FakeReply<ItemInfoList> GetAllItemInfos();
+    FakeReply<QStringList> GetAllNewInstalledApps();
+    FakeReply<> MarkLaunched(const QString &in0);
+    FakeReply<> RequestUninstall(const QString &in0, bool in1);
+    FakeReply<> Search(const QString &in0);
+
+Q_SIGNALS: // SIGNALS
+    void ItemChanged(const QString &in0, ItemInfo in1, qlonglong in2);
+    void NewAppLaunched(const QString &in0);
+    void SearchDone(const QStringList &in0);
+    void UninstallFailed(const QString &in0, const QString &in1);
+    void UninstallSuccess(const QString &in0);
+
+private:
+    static ItemInfoList Apps;
+};
+
+#endif // DBUSLAUNCHER_H
@@ -0,0 +1,14 @@
+#include "dbustartmanager.h"
+
+DBusStartManager::DBusStartManager(QObject *parent) :
+    QObject(parent)
+{
+}
+
+FakeReply<bool> DBusStartManager::LaunchWithTimestamp(const QString &in0, uint in1)
+{
+    Q_UNUSED(in0)
+    Q_UNUSED(in1)
+
+    return false;
+}
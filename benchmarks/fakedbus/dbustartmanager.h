@@ -0,0 +1,25 @@
+#ifndef DBUSTARTMANAGER_H
+#define DBUSTARTMANAGER_H
+
+#include "fakereply.h"
+
+#include <QObject>
+
+///
+/// \brief The DBusStartManager class is an in-process fake of start manager, apps are never launched
+///
+class DBusStartManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DBusStartManager(QObject *parent = 0);
+
+public Q_SLOTS: // METHODS
+    FakeReply<bool> LaunchWithTimestamp(const QString &in0, uint in1);
+
+Q_SIGNALS: // SIGNALS
+    void AutostartChanged(const QString &in0, const QString &in1);
+};
+
+#endif // DBUSTARTMANAGER_H
@@ -0,0 +1,46 @@
+#ifndef FAKEREPLY_H
+#define FAKEREPLY_H
+
+#include <QtDBus/QtDBus>
+
+///
+/// \brief The FakeReply class is a finished reply of in-process fake daemons, it replaces QDBusPendingReply
+///
+/// values are read by value() directly. a reply converted to QDBusPendingCall,
+/// e.g. for QDBusPendingCallWatcher, is an error reply, because fake daemons
+/// don't marshal values.
+///
+template <typename T = void>
+class FakeReply
+{
+public:
+    FakeReply(const T &value = T()) : m_value(value) {}
+
+    inline bool isValid() const {return true;}
+    inline bool isError() const {return false;}
+    inline bool isFinished() const {return true;}
+    inline void waitForFinished() const {}
+    inline const T &value() const {return m_value;}
+    inline operator T() const {return m_value;}
+
+    operator QDBusPendingCall() const
+    {
+        const QDBusMessage call = QDBusMessage::createMethodCall("com.deepin.dde.launcher.Fake", "/", "com.deepin.dde.launcher.Fake", "Call");
+        return QDBusPendingCall::fromCompletedCall(call.createErrorReply(QDBusError::NotSupported, "not supported by fake daemon"));
+    }
+
+private:
+    T m_value;
+};
+
+template <>
+class FakeReply<void>
+{
+public:
+    inline bool isValid() const {return true;}
+    inline bool isError() const {return false;}
+    inline bool isFinished() const {return true;}
+    inline void waitForFinished() const {}
+};
+
+#endif // FAKEREPLY_H
@@ -0,0 +1,294 @@
+#include "launcherbenchmark.h"
+#include "dbuslauncher.h"
+#include "model/appsmanager.h"
+#include "model/appslistmodel.h"
+#include "model/appssearchindex.h"
+#include "delegate/appitemdelegate.h"
+#include "global_util/calculate_util.h"
+
+#include <QtTest>
+#include <QPainter>
+#include <QPixmap>
+#include <QStandardPaths>
+#include <QDir>
+#include <QFile>
+
+static const QList<int> AppCounts = {100, 1000, 10000};
+
+void LauncherBenchmark::initTestCase()
+{
+    // start without snapshot, icon atlas and user sorted order of the last run
+    QStandardPaths::setTestModeEnabled(true);
+    QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).removeRecursively();
+    QFile::remove(QStandardPaths::writableLocation(QStandardPaths::GenericConfigLocation) + "/deepin/dde-launcher-app-order");
+
+    CalculateUtil::instance(qApp)->calculateAppLayout(QSize(1280, 800), 2);
+    m_appsManager = AppsManager::instance(qApp);
+}
+
+void LauncherBenchmark::addCountRows()
+{
+    QTest::addColumn<int>("count");
+
+    for (const int count : AppCounts)
+        QTest::newRow(QByteArray::number(count)) << count;
+}
+
+///
+/// \brief LauncherBenchmark::loadApps replace apps of fake daemon and reload them like a full refresh
+///
+void LauncherBenchmark::loadApps(const int count)
+{
+    DBusLauncher::setApps(DBusLauncher::syntheticApps(count));
+    m_appsManager->refreshCategoryInfoList();
+}
+
+void LauncherBenchmark::generateCategoryMap_data()
+{
+    addCountRows();
+}
+
+void LauncherBenchmark::generateCategoryMap()
+{
+    QFETCH(int, count);
+    loadApps(count);
+
+    QBENCHMARK {
+        m_appsManager->generateCategoryMap();
+    }
+}
+
+void LauncherBenchmark::sortByPresetOrder_data()
+{
+    addCountRows();
+}
+
+void LauncherBenchmark::sortByPresetOrder()
+{
+    QFETCH(int, count);
+    loadApps(count);
+
+    const ItemInfoList apps = m_appsManager->m_appsCatalog.items();
+
+    QBENCHMARK {
+        ItemInfoList list = apps;
+        m_appsManager->sortByPresetOrder(list);
+    }
+}
+
+void LauncherBenchmark::searchDone_data()
+{
+    addCountRows();
+}
+
+void LauncherBenchmark::searchDone()
+{
+    QFETCH(int, count);
+    loadApps(count);
+
+    // about a quarter of apps matched, like a short query
+    QStringList resultList;
+    const ItemInfoList &apps = m_appsManager->appsInfoList(AppsListModel::All);
+    for (int i(0); i < apps.size(); i += 4)
+        resultList.append(apps[i].m_key);
+
+    QBENCHMARK {
+        m_appsManager->searchDone(resultList);
+    }
+}
+
+void LauncherBenchmark::searchIndexBuild_data()
+{
+    addCountRows();
+}
+
+void LauncherBenchmark::searchIndexBuild()
+{
+    QFETCH(int, count);
+
+    const ItemInfoList apps = DBusLauncher::syntheticApps(count);
+    AppsSearchIndex index;
+
+    QBENCHMARK {
+        index.setApps(apps, QHash<QString, QStringList>());
+    }
+}
+
+void LauncherBenchmark::searchIndexQuery_data()
+{
+    addCountRows();
+}
+
+void LauncherBenchmark::searchIndexQuery()
+{
+    QFETCH(int, count);
+
+    AppsSearchIndex index;
+    index.setApps(DBusLauncher::syntheticApps(count), QHash<QString, QStringList>());
+
+    // type a query character by character, every key stroke searches once
+    const QString query("music");
+
+    QBENCHMARK {
+        index.search(QString());
+        for (int i(1); i <= query.size(); ++i)
+            index.search(query.left(i));
+    }
+}
+
+void LauncherBenchmark::modelData_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("role");
+
+    const QList<QPair<const char *, int>> roles = {
+        {"AppNameRole", AppsListModel::AppNameRole},
+        {"AppIconRole", AppsListModel::AppIconRole},
+        {"AppKeyRole", AppsListModel::AppKeyRole},
+        {"AppDesktopRole", AppsListModel::AppDesktopRole},
+        {"AppAutoStartRole", AppsListModel::AppAutoStartRole},
+        {"AppNewInstallRole", AppsListModel::AppNewInstallRole},
+        {"AppIsOnDesktopRole", AppsListModel::AppIsOnDesktopRole},
+        {"AppIsOnDockRole", AppsListModel::AppIsOnDockRole},
+        {"AppIsRemovableRole", AppsListModel::AppIsRemovableRole},
+        {"ItemSizeHintRole", AppsListModel::ItemSizeHintRole},
+        {"AppIconSizeRole", AppsListModel::AppIconSizeRole},
+        {"AppFontSizeRole", AppsListModel::AppFontSizeRole},
+    };
+
+    for (const int count : AppCounts)
+        for (const auto &role : roles)
+            QTest::newRow(QString("%1/%2").arg(count).arg(role.first).toLatin1()) << count << role.second;
+}
+
+void LauncherBenchmark::modelData()
+{
+    QFETCH(int, count);
+    QFETCH(int, role);
+    loadApps(count);
+
+    AppsListModel appsModel(AppsListModel::All);
+    const QAbstractItemModel *model = &appsModel;
+    const int rows = model->rowCount(QModelIndex());
+
+    QBENCHMARK {
+        for (int i(0); i != rows; ++i)
+            model->index(i, 0).data(role);
+    }
+}
+
+void LauncherBenchmark::paintRoles_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<QString>("access");
+
+    // copy: every role query copies the row list and item, as data() did before
+    // cold: rows are read by reference, lookups in AppsManager are not cached yet
+    // warm: rows are read by reference, lookups are served from role cache
+    for (const int count : AppCounts)
+        for (const QString &access : {QString("copy"), QString("cold"), QString("warm")})
+            QTest::newRow(QString("%1/%2").arg(count).arg(access).toLatin1()) << count << access;
+}
+
+///
+/// \brief LauncherBenchmark::paintRoles query all roles one delegate paint needs, for every row
+///
+void LauncherBenchmark::paintRoles()
+{
+    QFETCH(int, count);
+    QFETCH(QString, access);
+    loadApps(count);
+
+    static const QList<int> roles = {AppsListModel::AppItemIsDragingRole, AppsListModel::AppIconRole,
+                                     AppsListModel::AppFontSizeRole, AppsListModel::AppNewInstallRole,
+                                     AppsListModel::AppAutoStartRole, AppsListModel::AppNameRole,
+                                     AppsListModel::AppKeyRole};
+
+    AppsListModel appsModel(AppsListModel::All);
+    const QAbstractItemModel *model = &appsModel;
+    const int rows = model->rowCount(QModelIndex());
+
+    if (access == "copy")
+    {
+        QBENCHMARK {
+            for (int i(0); i != rows; ++i)
+            {
+                const QModelIndex index = model->index(i, 0);
+                for (const int role : roles)
+                {
+                    const ItemInfoList list = m_appsManager->appsInfoList(appsModel.category());
+                    const ItemInfo itemInfo = list[index.row()];
+                    appsModel.roleData(itemInfo, index, role);
+                }
+            }
+        }
+    } else {
+        const bool cold = access == "cold";
+
+        QBENCHMARK {
+            if (cold)
+                appsModel.m_roleCache.clear();
+
+            for (int i(0); i != rows; ++i)
+            {
+                const QModelIndex index = model->index(i, 0);
+                for (const int role : roles)
+                    index.data(role);
+            }
+        }
+    }
+}
+
+void LauncherBenchmark::delegatePaint_data()
+{
+    addCountRows();
+}
+
+void LauncherBenchmark::delegatePaint()
+{
+    QFETCH(int, count);
+    loadApps(count);
+
+    AppsListModel appsModel(AppsListModel::All);
+    AppItemDelegate appDelegate;
+    const QAbstractItemModel *model = &appsModel;
+    const QAbstractItemDelegate *delegate = &appDelegate;
+
+    const QSize itemSize = CalculateUtil::instance()->appItemSize();
+    const int rows = model->rowCount(QModelIndex());
+
+    QPixmap canvas(itemSize);
+    QStyleOptionViewItem option;
+    option.rect = QRect(QPoint(0, 0), itemSize);
+
+    QBENCHMARK {
+        QPainter painter(&canvas);
+        for (int i(0); i != rows; ++i)
+            delegate->paint(&painter, option, model->index(i, 0));
+    }
+}
+
+void LauncherBenchmark::holdTextInRect_data()
+{
+    addCountRows();
+}
+
+void LauncherBenchmark::holdTextInRect()
+{
+    QFETCH(int, count);
+
+    const ItemInfoList apps = DBusLauncher::syntheticApps(count);
+    const AppItemDelegate delegate;
+
+    QFont font;
+    font.setPixelSize(CalculateUtil::instance()->appItemFontSize());
+    const QFontMetrics fm(font);
+    const QRect rect(0, 0, CalculateUtil::instance()->appItemSize().width(), fm.height() * 2);
+
+    QBENCHMARK {
+        for (const ItemInfo &info : apps)
+            delegate.holdTextInRect(fm, info.m_name, rect);
+    }
+}
+
+QTEST_MAIN(LauncherBenchmark)
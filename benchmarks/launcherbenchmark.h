@@ -0,0 +1,49 @@
+#ifndef LAUNCHERBENCHMARK_H
+#define LAUNCHERBENCHMARK_H
+
+#include <QObject>
+
+class AppsManager;
+
+///
+/// \brief The LauncherBenchmark class measures hot paths of apps model and delegate with 100, 1k and 10k apps
+///
+/// apps come from fake daemons in fakedbus/, so results don't depend on
+/// apps installed on the machine. run with "-tickcounter" or "-callgrind"
+/// for stable numbers.
+///
+class LauncherBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void generateCategoryMap_data();
+    void generateCategoryMap();
+    void sortByPresetOrder_data();
+    void sortByPresetOrder();
+    void searchDone_data();
+    void searchDone();
+    void searchIndexBuild_data();
+    void searchIndexBuild();
+    void searchIndexQuery_data();
+    void searchIndexQuery();
+    void modelData_data();
+    void modelData();
+    void paintRoles_data();
+    void paintRoles();
+    void delegatePaint_data();
+    void delegatePaint();
+    void holdTextInRect_data();
+    void holdTextInRect();
+
+private:
+    void addCountRows();
+    void loadApps(const int count);
+
+private:
+    AppsManager *m_appsManager = nullptr;
+};
+
+#endif // LAUNCHERBENCHMARK_H
@@ -12,11 +12,21 @@
 #include <QScreen>
 #include <QTimer>
 #include <QCryptographicHash>
+#include <QImageReader>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QUrl>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 
 #include "boxframe.h"
 
 static const QString DefaultBackground = "/usr/share/backgrounds/default_background.jpg";
 static const QString BlurredImageDir = "/var/cache/image-blur/";
+// interval to check if blurred image is completely written
+static const int BlurredImageCheckInterval = 200;
+// give up waiting after 5 seconds, the blurred image may never be completed
+static const int BlurredImageMaxChecks = 25;
 
 static QString GetBlurredImagePath(QString path) {
     QString ext = path.split(".").last();
@@ -24,17 +34,86 @@ static QString GetBlurredImagePath(QString path) {
     return BlurredImageDir + QString("%1.%2").arg(md5).arg(ext);
 }
 
+// decode image straight to a size expanding target size, then crop the center part.
+// this function runs in worker threads.
+static QImage ReadScaledImage(const QString &path, const QSize &size) {
+    QImageReader reader(path);
+
+    // let decoder skip pixels we don't need, JPEG decoder does most of the work for free
+    const QSize imageSize = reader.size();
+    if (imageSize.isValid()) {
+        const QSize expandedSize = imageSize.scaled(size, Qt::KeepAspectRatioByExpanding);
+        if (expandedSize.width() < imageSize.width())
+            reader.setScaledSize(expandedSize);
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) return image;
+
+    const QSize expandedSize = image.size().scaled(size, Qt::KeepAspectRatioByExpanding);
+    if (expandedSize != image.size())
+        image = image.scaled(expandedSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+    QRect copyRect((image.width() - size.width()) / 2,
+                   (image.height() - size.height()) / 2,
+                   size.width(), size.height());
+
+    return image.copy(copyRect).convertToFormat(QImage::Format_RGB32);
+}
+
+static QString LocalPath(const QString &url) {
+    return QUrl(url).isLocalFile() ? QUrl(url).toLocalFile() : url;
+}
+
+// this function runs in worker threads.
+static QByteArray HashFile(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(&file);
+
+    return hash.result();
+}
+
+static QImage LoadBackground(const QString &url, const QSize &size) {
+    const QString path = LocalPath(url);
+    const QString blurredPath = GetBlurredImagePath(path);
+
+    QImage image;
+    if (QFile::exists(blurredPath)) {
+        image = ReadScaledImage(blurredPath, size);
+    }
+    if (image.isNull()) {
+        image = ReadScaledImage(path, size);
+    }
+    if (image.isNull()) {
+        image = ReadScaledImage(DefaultBackground, size);
+    }
+
+    return image;
+}
+
 BoxFrame::BoxFrame(QWidget *parent)
-    : QFrame(parent)
+    : QFrame(parent),
+      m_backgroundSerial(0),
+      m_readySerial(-1),
+      m_blurredImagePendingSize(-1),
+      m_blurredImageChecks(0),
+      m_blurredImageTimer(new QTimer(this))
 {
-    m_blurredImageWatcher.addPath(BlurredImageDir);
-    connect(&m_blurredImageWatcher, &QFileSystemWatcher::directoryChanged, [this](const QString &){
-        // NOTE: the direcotryChanged signal is triggered when the blurred background
-        // is about being written to the disk. It's not completed yet.
-        QTimer::singleShot(500, this, SLOT(resetBackground()));
+    m_blurredImageTimer->setSingleShot(true);
+    m_blurredImageTimer->setInterval(BlurredImageCheckInterval);
 
-        emit backgroundChanged();
+    // directory is watched to know when the blurred image is created,
+    // the file itself is watched after that.
+    m_blurredImageWatcher.addPath(BlurredImageDir);
+    connect(&m_blurredImageWatcher, &QFileSystemWatcher::directoryChanged, this, &BoxFrame::blurredImageChanged);
+    connect(&m_blurredImageWatcher, &QFileSystemWatcher::fileChanged, this, [this] (const QString &path) {
+        if (path == m_blurredImagePath)
+            blurredImageChanged();
     });
+    connect(m_blurredImageTimer, &QTimer::timeout, this, &BoxFrame::checkBlurredImage);
 }
 
 BoxFrame::BoxFrame(const QString &url, QWidget *parent)
@@ -53,43 +132,201 @@ BoxFrame::~BoxFrame()
 // ShutdownFrame takes ~260ms to complete. On the other hand, this function takes
 // ~130ms by setting pixmap, yet takes only ~12ms to complete the show() of ShutdownFrame.
 // It'll be more obvious on dual screens environment.
+//
+// The wallpaper is decoded and scaled to the primary screen size in a worker thread,
+// the old background is kept until the new one is ready.
 void BoxFrame::setBackground(const QString &url, bool force)
 {
     if (m_lastUrl == url && !force) return;
 
-    m_lastUrl = url;
-    const QString path = QUrl(url).isLocalFile() ? QUrl(url).toLocalFile() : url;
+    if (m_lastUrl != url)
+        watchBlurredImage(url);
 
-    QPixmap pix(path);
-    QString blurredPath = GetBlurredImagePath(path);
-    if (QFile::exists(blurredPath)) {
-        pix = QPixmap(blurredPath);
-    }
-    if (pix.isNull()) {
-        pix.load(DefaultBackground);
-    }
+    m_lastUrl = url;
+    ++m_backgroundSerial;
+    m_pending.clear();
 
-    m_pixmap = pix;
-    m_cache = QPixmap();
-    emit backgroundChanged();
+    // frame may not be resized to screen yet, other sizes are prepared on demand
+    requestBackground(qApp->primaryScreen()->size());
 }
 
 QPixmap BoxFrame:: getBackground()
 {
-    if (m_cache.isNull() || size() != m_cache.size()) {
-        QPixmap cache = m_pixmap.scaled(size(), Qt::KeepAspectRatioByExpanding);
+    const SizeKey key(width(), height());
 
-        QRect copyRect((cache.width() - size().width()) / 2,
-                       (cache.height() - size().height()) / 2,
-                       size().width(), size().height());
+    if (m_readySerial == m_backgroundSerial && m_caches.contains(key))
+        return m_caches.value(key);
 
-        m_cache = cache.copy(copyRect);
+    // nothing was ever ready, decode the first frame here once instead of showing a plain fill.
+    if (m_caches.isEmpty()) {
+        storeBackground(m_backgroundSerial, size(), LoadBackground(m_lastUrl, size()));
+        return m_caches.value(key);
     }
 
-    return m_cache;
+    requestBackground(size());
+
+    // keep showing the old background until the new one is ready
+    if (m_caches.contains(key))
+        return m_caches.value(key);
+
+    if (m_interimKey == key && !m_interim.isNull())
+        return m_interim;
+
+    // never wait for worker in GUI thread, scale the closest ready size.
+    // backgroundChanged is emitted when the wanted one is ready.
+    m_interimKey = key;
+    auto closest = m_caches.constBegin();
+    for (auto it(m_caches.constBegin()); it != m_caches.constEnd(); ++it) {
+        if (qAbs(it.key().first - key.first) + qAbs(it.key().second - key.second) <
+                qAbs(closest.key().first - key.first) + qAbs(closest.key().second - key.second))
+            closest = it;
+    }
+
+    const QPixmap pix = closest.value().scaled(size(), Qt::KeepAspectRatioByExpanding);
+    QRect copyRect((pix.width() - size().width()) / 2,
+                   (pix.height() - size().height()) / 2,
+                   size().width(), size().height());
+    m_interim = pix.copy(copyRect);
+
+    return m_interim;
 }
 
 void BoxFrame::resetBackground()
 {
     setBackground(m_lastUrl, true);
 }
+
+void BoxFrame::requestBackground(const QSize &size)
+{
+    const SizeKey key(size.width(), size.height());
+    if (m_pending.contains(key)) return;
+
+    const int serial = m_backgroundSerial;
+    const QString url = m_lastUrl;
+
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [=] {
+        watcher->deleteLater();
+
+        // background is changed or already waited in getBackground
+        if (serial != m_backgroundSerial || !m_pending.contains(key)) return;
+
+        storeBackground(serial, size, watcher->result());
+        emit backgroundChanged();
+    });
+
+    const QFuture<QImage> future = QtConcurrent::run(LoadBackground, url, size);
+    m_pending.insert(key, future);
+    watcher->setFuture(future);
+}
+
+// NOTE: the blurred image is written by the daemon in several steps, directoryChanged
+// and fileChanged are triggered before it's completed. wait until the file size
+// keeps the same, and reload only if the content is really changed.
+void BoxFrame::blurredImageChanged()
+{
+    if (m_blurredImagePath.isEmpty()) return;
+
+    const QFileInfo info(m_blurredImagePath);
+    if (!info.exists()) return;
+
+    // file is removed from watcher when it's replaced
+    if (!m_blurredImageWatcher.files().contains(m_blurredImagePath))
+        m_blurredImageWatcher.addPath(m_blurredImagePath);
+
+    // other files in the cache dir are changed
+    if (FileStamp(info.size(), info.lastModified().toMSecsSinceEpoch()) == m_blurredImageStamp)
+        return;
+
+    m_blurredImagePendingSize = -1;
+    m_blurredImageChecks = 0;
+    m_blurredImageTimer->start();
+}
+
+void BoxFrame::checkBlurredImage()
+{
+    const QFileInfo info(m_blurredImagePath);
+
+    // still being written
+    if (!info.exists() || info.size() == 0 || info.size() != m_blurredImagePendingSize) {
+        m_blurredImagePendingSize = info.size();
+
+        if (++m_blurredImageChecks < BlurredImageMaxChecks) {
+            m_blurredImageTimer->start();
+            return;
+        }
+
+        // blurred image is broken or removed, reload and fall back to the original wallpaper
+        qWarning() << "blurred image is not completed, give up waiting" << m_blurredImagePath;
+        m_blurredImagePendingSize = -1;
+        m_blurredImageStamp = FileStamp(info.size(), info.lastModified().toMSecsSinceEpoch());
+        m_blurredImageHash.clear();
+        resetBackground();
+        return;
+    }
+
+    m_blurredImagePendingSize = -1;
+    m_blurredImageStamp = FileStamp(info.size(), info.lastModified().toMSecsSinceEpoch());
+
+    hashBlurredImage(true);
+}
+
+void BoxFrame::watchBlurredImage(const QString &url)
+{
+    if (!m_blurredImagePath.isEmpty())
+        m_blurredImageWatcher.removePath(m_blurredImagePath);
+
+    m_blurredImageTimer->stop();
+    m_blurredImagePendingSize = -1;
+    m_blurredImageHash.clear();
+    m_blurredImagePath = GetBlurredImagePath(LocalPath(url));
+
+    const QFileInfo info(m_blurredImagePath);
+    m_blurredImageStamp = FileStamp(info.size(), info.lastModified().toMSecsSinceEpoch());
+
+    if (!info.exists()) return;
+
+    m_blurredImageWatcher.addPath(m_blurredImagePath);
+
+    // remember content of the current blurred image, a rewrite with the same content is ignored
+    hashBlurredImage(false);
+}
+
+void BoxFrame::hashBlurredImage(const bool reload)
+{
+    const QString path = m_blurredImagePath;
+
+    QFutureWatcher<QByteArray> *watcher = new QFutureWatcher<QByteArray>(this);
+    connect(watcher, &QFutureWatcher<QByteArray>::finished, this, [=] {
+        watcher->deleteLater();
+
+        // background is changed
+        if (path != m_blurredImagePath) return;
+
+        const QByteArray hash = watcher->result();
+        if (hash.isEmpty() || hash == m_blurredImageHash) return;
+
+        m_blurredImageHash = hash;
+        if (reload)
+            resetBackground();
+    });
+
+    watcher->setFuture(QtConcurrent::run(HashFile, path));
+}
+
+// swap in the prepared background, called in GUI thread only.
+void BoxFrame::storeBackground(const int serial, const QSize &size, const QImage &image)
+{
+    const SizeKey key(size.width(), size.height());
+    m_pending.remove(key);
+
+    if (m_readySerial != serial) {
+        m_readySerial = serial;
+        m_caches.clear();
+    }
+
+    m_caches.insert(key, QPixmap::fromImage(image));
+
+    // a closer size may be ready now
+    m_interim = QPixmap();
+}
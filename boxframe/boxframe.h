@@ -19,7 +19,13 @@
 
 #include <QFrame>
 #include <QLabel>
+#include <QPixmap>
 #include <QFileSystemWatcher>
+#include <QFuture>
+#include <QHash>
+#include <QPair>
+
+class QTimer;
 
 class BoxFrame : public QFrame
 {
@@ -38,12 +44,43 @@ signals:
 
 private slots:
     void resetBackground();
+    void blurredImageChanged();
+    void checkBlurredImage();
+
+private:
+    typedef QPair<int, int> SizeKey;
+    // size and last modified time of a file
+    typedef QPair<qint64, qint64> FileStamp;
+
+    void requestBackground(const QSize &size);
+    void storeBackground(const int serial, const QSize &size, const QImage &image);
+    void watchBlurredImage(const QString &url);
+    void hashBlurredImage(const bool reload);
 
 private:
     QString m_lastUrl;
-    QPixmap m_pixmap;
-    QPixmap m_cache;
+    // increased when background is changed, results of old backgrounds are dropped
+    int m_backgroundSerial;
+    // serial of background in m_caches
+    int m_readySerial;
+    // ready pixmaps of one background, per frame size
+    QHash<SizeKey, QPixmap> m_caches;
+    // pixmaps being prepared for m_backgroundSerial
+    QHash<SizeKey, QFuture<QImage>> m_pending;
+    // shown while the wanted size is being prepared, scaled from the closest ready size
+    QPixmap m_interim;
+    SizeKey m_interimKey;
     QFileSystemWatcher m_blurredImageWatcher;
+
+    // blurred image of m_lastUrl, other files in the cache dir are ignored
+    QString m_blurredImagePath;
+    FileStamp m_blurredImageStamp;
+    QByteArray m_blurredImageHash;
+    // size seen in last check, file is complete when size keeps the same between checks
+    qint64 m_blurredImagePendingSize;
+    // checks since the last change, waiting stops at a limit
+    int m_blurredImageChecks;
+    QTimer *m_blurredImageTimer;
 };
 
 #endif // BOXFRAME_H
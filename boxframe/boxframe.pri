@@ -1,6 +1,6 @@
 INCLUDEPATH +=$$PWD
 
-QT += dbus core
+QT += dbus core concurrent
 
 HEADERS += \
     $$PWD/boxframe.h \
@@ -7,13 +7,10 @@ HEADERS += \
     $$PWD/dbusvariant/iteminfo.h \
     $$PWD/dbusdisplay.h \
     $$PWD/dbusfileinfo.h \
-    $$PWD/dbuslauncher.h \
     $$PWD/dbuslauncherframe.h \
     $$PWD/dbusmenu.h \
     $$PWD/dbusmenumanager.h \
-    $$PWD/dbustartmanager.h \
-    $$PWD/monitorinterface.h \
-    $$PWD/dbusdock.h
+    $$PWD/monitorinterface.h
 
 SOURCES += \
     $$PWD/dbusvariant/categoryinfo.cpp \
@@ -22,10 +19,20 @@ SOURCES += \
     $$PWD/dbusvariant/iteminfo.cpp \
     $$PWD/dbusdisplay.cpp \
     $$PWD/dbusfileinfo.cpp \
-    $$PWD/dbuslauncher.cpp \
     $$PWD/dbuslauncherframe.cpp \
     $$PWD/dbusmenu.cpp \
     $$PWD/dbusmenumanager.cpp \
-    $$PWD/dbustartmanager.cpp \
-    $$PWD/monitorinterface.cpp \
-    $$PWD/dbusdock.cpp
+    $$PWD/monitorinterface.cpp
+
+# daemons apps come from, replaced by in-process fakes in benchmarks
+!fake_daemon {
+    HEADERS += \
+        $$PWD/dbuslauncher.h \
+        $$PWD/dbustartmanager.h \
+        $$PWD/dbusdock.h
+
+    SOURCES += \
+        $$PWD/dbuslauncher.cpp \
+        $$PWD/dbustartmanager.cpp \
+        $$PWD/dbusdock.cpp
+}
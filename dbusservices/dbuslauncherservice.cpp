@@ -9,6 +9,7 @@
  */
 
 #include "dbuslauncherservice.h"
+#include "model/appsmanager.h"
 
 #include <QtCore/QMetaObject>
 #include <QtCore/QByteArray>
@@ -28,6 +29,9 @@ DBusLauncherService::DBusLauncherService(MainFrame *parent)
 {
     // constructor
     setAutoRelaySignals(true);
+
+    // HAND-EDIT: announce shared catalog of apps
+    connect(AppsManager::instance(), &AppsManager::catalogPublished, this, &DBusLauncherService::CatalogChanged);
 }
 
 DBusLauncherService::~DBusLauncherService()
@@ -56,6 +60,7 @@ void DBusLauncherService::Show()
 //    parent()->Show();
     QX11Info::setAppTime(QX11Info::getTimestamp());
     QX11Info::setAppUserTime(QX11Info::getTimestamp());
+    parent()->startShowTiming();
     parent()->show();
     emit Shown();
 }
@@ -87,8 +92,25 @@ void DBusLauncherService::Toggle()
     {
         QX11Info::setAppTime(QX11Info::getTimestamp());
         QX11Info::setAppUserTime(QX11Info::getTimestamp());
+        parent()->startShowTiming();
         parent()->show();
         emit Shown();
     }
 }
 
+
+qlonglong DBusLauncherService::ShowLatency(qlonglong &average, int &count)
+{
+    // handle method call com.deepin.dde.Launcher.ShowLatency
+    average = parent()->averageShowLatency();
+    count = parent()->showCount();
+
+    return parent()->lastShowLatency();
+}
+
+QString DBusLauncherService::CatalogSegment()
+{
+    // handle method call com.deepin.dde.Launcher.CatalogSegment
+    return AppsManager::instance()->catalogSegment();
+}
+
@@ -46,8 +46,20 @@ class DBusLauncherService: public QDBusAbstractAdaptor
 "      <arg direction=\"in\" type=\"s\"/>\n"
 "    </method>\n"
 #endif
+"    <method name=\"ShowLatency\">\n"
+"      <arg name=\"last\" direction=\"out\" type=\"x\"/>\n"
+"      <arg name=\"average\" direction=\"out\" type=\"x\"/>\n"
+"      <arg name=\"count\" direction=\"out\" type=\"i\"/>\n"
+"    </method>\n"
+"    <method name=\"CatalogSegment\">\n"
+"      <arg direction=\"out\" type=\"s\"/>\n"
+"    </method>\n"
 "    <signal name=\"Closed\"/>\n"
 "    <signal name=\"Shown\"/>\n"
+"    <signal name=\"CatalogChanged\">\n"
+"      <arg type=\"s\"/>\n"
+"      <arg type=\"t\"/>\n"
+"    </signal>\n"
 "  </interface>\n"
         "")
 public:
@@ -67,9 +79,12 @@ public Q_SLOTS: // METHODS
     void UninstallApp(const QString &appKey);
 #endif
     void Toggle();
+    qlonglong ShowLatency(qlonglong &average, int &count);
+    QString CatalogSegment();
 Q_SIGNALS: // SIGNALS
     void Closed();
     void Shown();
+    void CatalogChanged(const QString &segment, qulonglong generation);
 };
 
 #endif
@@ -2,11 +2,13 @@
 #include "appitemdelegate.h"
 #include "global_util/constants.h"
 #include "global_util/calculate_util.h"
+#include "global_util/perftrace.h"
 #include "model/appslistmodel.h"
 #include "dbusinterface/dbusvariant/iteminfo.h"
 
 #include <QDebug>
 #include <QPixmap>
+#include <QPixmapCache>
 #include <QVariant>
 
 QModelIndex AppItemDelegate::CurrentIndex = QModelIndex();
@@ -17,7 +19,11 @@ AppItemDelegate::AppItemDelegate(QObject *parent) :
     m_blueDotPixmap(":/skin/images/new_install_indicator.png"),
     m_autoStartPixmap(":/skin/images/emblem-autostart.png")
 {
+    // tiles of all visible items should fit in cache
+    QPixmapCache::setCacheLimit(qMax(QPixmapCache::cacheLimit(), 40960));
 
+    // font size or item size is changed
+    connect(m_calcUtil, &CalculateUtil::layoutChanged, this, [this] {m_textLayoutCache.clear();});
 }
 
 void AppItemDelegate::setCurrentIndex(const QModelIndex &index)
@@ -33,6 +39,8 @@ void AppItemDelegate::setCurrentIndex(const QModelIndex &index)
 
 void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
+    PERF_TRACE("AppItemDelegate::paint");
+
     if (index.data(AppsListModel::AppItemIsDragingRole).value<bool>() && !(option.features & QStyleOptionViewItem::HasDisplay))
         return;
 
@@ -41,11 +49,7 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
     painter->setBrush(QBrush(Qt::transparent));
 
     const int leftMargin = 2, radius = 10;
-    const int fontPixelSize = index.data(AppsListModel::AppFontSizeRole).value<int>();
-    const bool drawBlueDot = index.data(AppsListModel::AppNewInstallRole).toBool();
-    const ItemInfo itemInfo = index.data(AppsListModel::AppRawItemInfoRole).value<ItemInfo>();
     const QRect boundingRect = itemBoundingRect(option.rect);
-    const QSize iconSize = index.data(AppsListModel::AppIconSizeRole).toSize();
 
     // draw focus background
    if (CurrentIndex == index && !(option.features & QStyleOptionViewItem::HasDisplay))
@@ -66,45 +70,93 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
                                  radius, radius);
     }
 
+    // draw icon, name and indicators from pre-rendered tile
+    painter->drawPixmap(boundingRect.topLeft(), itemTile(index, boundingRect.size(), painter->font(), painter->device()->devicePixelRatioF()));
+}
+
+///
+/// \brief AppItemDelegate::itemTile get the rendered item without focus background, tiles are kept in QPixmapCache
+/// \param index item index
+/// \param size item bounding rect size
+/// \param font base font of app name
+/// \param ratio device pixel ratio of paint device
+///
+const QPixmap AppItemDelegate::itemTile(const QModelIndex &index, const QSize &size, const QFont &font, const qreal ratio) const
+{
+    const QPixmap icon = index.data(AppsListModel::AppIconRole).value<QPixmap>();
+    const int fontPixelSize = index.data(AppsListModel::AppFontSizeRole).value<int>();
+    const bool drawBlueDot = index.data(AppsListModel::AppNewInstallRole).toBool();
+    const bool drawAutoStart = index.data(AppsListModel::AppAutoStartRole).toBool();
+    const QString appName = index.data(AppsListModel::AppNameRole).toString();
+
+    // substitute all at once, "%N" in app key or name must not be replaced by a later arg()
+    const QString key = QString("dde-launcher-tile-%1-%2x%3-%4-%5-%6-%7-%8-%9")
+                            .arg(index.data(AppsListModel::AppKeyRole).toString(),
+                                 QString::number(size.width()), QString::number(size.height()),
+                                 QString::number(fontPixelSize),
+                                 QString::number(int(drawBlueDot) << 1 | int(drawAutoStart)),
+                                 QString::number(ratio),
+                                 QString::number(icon.cacheKey()),
+                                 font.key(),
+                                 appName);
+
+    QPixmap tile;
+    if (QPixmapCache::find(key, &tile))
+        return tile;
+
+    tile = QPixmap(size * ratio);
+    tile.setDevicePixelRatio(ratio);
+    tile.fill(Qt::transparent);
+
+    QPainter painter(&tile);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform);
+    painter.setFont(font);
+    paintItemContent(&painter, QRect(QPoint(0, 0), size), icon, appName, fontPixelSize, drawBlueDot, drawAutoStart);
+    painter.end();
+
+    QPixmapCache::insert(key, tile);
+
+    return tile;
+}
+
+void AppItemDelegate::paintItemContent(QPainter *painter, const QRect &boundingRect, const QPixmap &icon, const QString &appName,
+                                       const int fontPixelSize, const bool drawBlueDot, const bool drawAutoStart) const
+{
+    const QSize iconSize = m_calcUtil->appIconSize();
+
     // draw app icon
     const int iconLeftMargins = (boundingRect.width() - iconSize.width()) / 2;
     const int iconTopMargin = qMin(10, int(boundingRect.height() * 0.1));
     const QRect iconRect = QRect(boundingRect.topLeft() + QPoint(iconLeftMargins, iconTopMargin), iconSize);
-    painter->drawPixmap(iconRect, index.data(AppsListModel::AppIconRole).value<QPixmap>());
+    painter->drawPixmap(iconRect, icon);
 
     // draw icon if app is auto startup
     const QPoint autoStartIconPos = iconRect.bottomLeft() - QPoint(0, m_autoStartPixmap.height());
-    if (index.data(AppsListModel::AppAutoStartRole).toBool())
+    if (drawAutoStart)
         painter->drawPixmap(autoStartIconPos, m_autoStartPixmap);
 
-    // draw app name
-    QTextOption appNameOption;
-    appNameOption.setAlignment(Qt::AlignHCenter | Qt::AlignTop);
-    appNameOption.setWrapMode(QTextOption::WordWrap);
+    // draw app name, shadow is drawn by the same shaped text with offset
     QFont appNamefont(painter->font());
     appNamefont.setPixelSize(fontPixelSize);
 
     const QFontMetrics fm(appNamefont);
     const QRectF appNameRect = itemTextRect(boundingRect, iconRect, drawBlueDot);
-//    const QRectF appNameBoundingRect = fm.boundingRect(appNameRect.toRect(), appNameOption.alignment() | wrapFlag, itemInfo.m_name);
-    const QString appText = holdTextInRect(fm, itemInfo.m_name, appNameRect.toRect());
-//    const QString appText = appNameBoundingRect.width() > appNameRect.width() || appNameBoundingRect.height() > appNameRect.height()
-//                                ? fm.elidedText(itemInfo.m_name, Qt::ElideRight, appNameRect.width(), appNameOption.alignment() | wrapFlag)
-//                                : itemInfo.m_name;
+    const TextLayout &appTextLayout = textLayout(appNamefont, appName, appNameRect.toRect());
+    const QStaticText &appText = appTextLayout.staticText;
 
     painter->setFont(appNamefont);
     painter->setBrush(QBrush(Qt::transparent));
     painter->setPen(QColor(0, 0, 0, 80));
-    painter->drawText(appNameRect.adjusted(0.8, 1, 0.8, 1), appText, appNameOption);
-    painter->drawText(appNameRect.adjusted(-0.8, 1, -0.8, 1), appText, appNameOption);
+    painter->drawStaticText(appNameRect.topLeft() + QPointF(0.8, 1), appText);
+    painter->drawStaticText(appNameRect.topLeft() + QPointF(-0.8, 1), appText);
     painter->setPen(Qt::white);
-    painter->drawText(appNameRect, appText, appNameOption);
+    painter->drawStaticText(appNameRect.topLeft(), appText);
 
     // draw blue dot if needed
     if (drawBlueDot)
     {
         const int marginRight = 2;
-        const QRectF textRect = fm.boundingRect(appNameRect.toRect(), Qt::AlignTop | Qt::AlignHCenter | Qt::TextWordWrap, appText);
+        const QRectF textRect = appTextLayout.boundingRect.translated(appNameRect.toRect().topLeft());
 
         const QPointF blueDotPos = textRect.topLeft() + QPoint(-m_blueDotPixmap.width() - marginRight, (fm.height() - m_blueDotPixmap.height()) / 2);
         painter->drawPixmap(blueDotPos, m_blueDotPixmap);
@@ -156,26 +208,66 @@ const QRect AppItemDelegate::itemTextRect(const QRect &boundingRect, const QRect
     return result.marginsRemoved(QMargins(widthMargin, heightMargin, widthMargin, heightMargin));
 }
 
+///
+/// \brief AppItemDelegate::holdTextInRect elide text to fit in rect
+/// \return text itself if it fits, otherwise the longest prefix of text followed by "..." which fits
+///
 const QString AppItemDelegate::holdTextInRect(const QFontMetrics &fm, const QString &text, const QRect &rect) const
 {
+    PERF_TRACE("AppItemDelegate::holdTextInRect");
+
     const int textFlag = Qt::AlignTop | Qt::AlignHCenter | Qt::TextWordWrap;
 
     if (rect.contains(fm.boundingRect(rect, textFlag, text)))
         return text;
 
-    QString str(text + "...");
-
-    while (true)
+    // binary search the longest prefix fits in rect
+    int low = 0;
+    int high = text.size();
+    while (low < high)
     {
-        if (str.size() < 4)
-            break;
+        const int mid = (low + high + 1) / 2;
+        if (rect.contains(fm.boundingRect(rect, textFlag, text.left(mid) + "...")))
+            low = mid;
+        else
+            high = mid - 1;
+    }
 
-        QRect boundingRect = fm.boundingRect(rect, textFlag, str);
-        if (rect.contains(boundingRect))
-            break;
+    return text.left(low) + "...";
+}
 
-        str.remove(str.size() - 4, 1);
-    }
+///
+/// \brief AppItemDelegate::textLayout get elided and shaped text, results are cached per font and text area size
+///
+const AppItemDelegate::TextLayout &AppItemDelegate::textLayout(const QFont &font, const QString &text, const QRect &rect) const
+{
+    const TextLayoutKey key = {text, font.key(), rect.size()};
+
+    const auto it = m_textLayoutCache.constFind(key);
+    if (it != m_textLayoutCache.constEnd())
+        return it.value();
+
+    // names of all apps in a few sizes, this should never be hit.
+    if (m_textLayoutCache.size() > 4096)
+        m_textLayoutCache.clear();
+
+    const QFontMetrics fm(font);
+    const QRect textRect(QPoint(0, 0), rect.size());
+
+    TextLayout layout;
+    layout.text = holdTextInRect(fm, text, textRect);
+    layout.boundingRect = fm.boundingRect(textRect, Qt::AlignTop | Qt::AlignHCenter | Qt::TextWordWrap, layout.text);
+
+    QTextOption textOption;
+    textOption.setAlignment(Qt::AlignHCenter | Qt::AlignTop);
+    textOption.setWrapMode(QTextOption::WordWrap);
+
+    layout.staticText.setTextFormat(Qt::PlainText);
+    layout.staticText.setPerformanceHint(QStaticText::AggressiveCaching);
+    layout.staticText.setTextOption(textOption);
+    layout.staticText.setTextWidth(textRect.width());
+    layout.staticText.setText(layout.text);
+    layout.staticText.prepare(QTransform(), font);
 
-    return str;
+    return *m_textLayoutCache.insert(key, layout);
 }
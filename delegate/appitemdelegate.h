@@ -5,12 +5,16 @@
 #include <QModelIndex>
 #include <QStyleOptionViewItem>
 #include <QPainter>
+#include <QHash>
+#include <QStaticText>
 
 class CalculateUtil;
 class AppItemDelegate : public QAbstractItemDelegate
 {
     Q_OBJECT
 
+    friend class LauncherBenchmark;
+
 public:
     explicit AppItemDelegate(QObject *parent = 0);
 
@@ -28,13 +32,45 @@ private:
     const QRect itemBoundingRect(const QRect &itemRect) const;
     const QRect itemTextRect(const QRect &boundingRect, const QRect &iconRect, const bool extraWidthMargin) const;
     const QString holdTextInRect(const QFontMetrics &fm, const QString &text, const QRect &rect) const;
+    const QPixmap itemTile(const QModelIndex &index, const QSize &size, const QFont &font, const qreal ratio) const;
+    void paintItemContent(QPainter *painter, const QRect &boundingRect, const QPixmap &icon, const QString &appName,
+                          const int fontPixelSize, const bool drawBlueDot, const bool drawAutoStart) const;
+
+public:
+    struct TextLayoutKey {
+        QString text;
+        // QFont::key(), text is measured again when family, style or size of font is changed
+        QString fontKey;
+        QSize size;
+
+        bool operator==(const TextLayoutKey &other) const
+        { return size == other.size && text == other.text && fontKey == other.fontKey; }
+    };
+
+    struct TextLayout {
+        QString text;
+        // bounding rect of elided text, relative to top left of text area
+        QRect boundingRect;
+        // shaped text, draw it at top left of text area
+        QStaticText staticText;
+    };
+
+private:
+    const TextLayout &textLayout(const QFont &font, const QString &text, const QRect &rect) const;
 
 private:
     CalculateUtil *m_calcUtil;
     QPixmap m_blueDotPixmap;
     QPixmap m_autoStartPixmap;
 
+    mutable QHash<TextLayoutKey, TextLayout> m_textLayoutCache;
+
     static QModelIndex CurrentIndex;
 };
 
+inline uint qHash(const AppItemDelegate::TextLayoutKey &key, uint seed = 0)
+{
+    return qHash(key.text, seed) ^ qHash(key.fontKey, seed) ^ uint(key.size.width() << 8) ^ uint(key.size.height());
+}
+
 #endif // APPITEMDELEGATE_H
@@ -0,0 +1,7 @@
+INCLUDEPATH += $$PWD
+
+HEADERS += \
+    $$PWD/appitemdelegate.h
+
+SOURCES += \
+    $$PWD/appitemdelegate.cpp
@@ -1,3 +1,16 @@
 !isEmpty(WITHOUT_UNINSTALL_APP) {
 	DEFINES += WITHOUT_UNINSTALL_APP
 }
+
+!isEmpty(WITH_DAEMON_SEARCH) {
+	DEFINES += WITH_DAEMON_SEARCH
+}
+
+!isEmpty(WITH_PERF_TRACE) {
+	DEFINES += WITH_PERF_TRACE
+}
+
+!isEmpty(WITH_NATIVE_ICON_THEME) {
+	DEFINES += WITH_NATIVE_ICON_THEME
+	PKGCONFIG -= gtk+-2.0
+}
@@ -0,0 +1,20 @@
+INCLUDEPATH += $$PWD
+
+HEADERS += \
+    $$PWD/constants.h \
+    $$PWD/util.h \
+    $$PWD/xcb_misc.h \
+    $$PWD/calculate_util.h \
+    $$PWD/perftrace.h \
+    $$PWD/themeappicon.h \
+    $$PWD/icontheme.h \
+    $$PWD/persiststore.h
+
+SOURCES += \
+    $$PWD/util.cpp \
+    $$PWD/xcb_misc.cpp \
+    $$PWD/calculate_util.cpp \
+    $$PWD/perftrace.cpp \
+    $$PWD/themeappicon.cpp \
+    $$PWD/icontheme.cpp \
+    $$PWD/persiststore.cpp
@@ -0,0 +1,519 @@
+#include "icontheme.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QTextStream>
+#include <QStandardPaths>
+#include <QDebug>
+
+#include <string.h>
+#include <climits>
+
+static const QString DefaultThemeName = "hicolor";
+
+// same bits as gtk icon cache flags
+enum IconSuffix {
+    SuffixNone = 0,
+    SuffixXpm = 1 << 0,
+    SuffixSvg = 1 << 1,
+    SuffixPng = 1 << 2,
+};
+
+static int SuffixOf(const QString &fileName)
+{
+    if (fileName.endsWith(".png"))
+        return SuffixPng;
+    if (fileName.endsWith(".svg"))
+        return SuffixSvg;
+    if (fileName.endsWith(".xpm"))
+        return SuffixXpm;
+
+    return SuffixNone;
+}
+
+// png is preferred, same as gtk best_suffix()
+static const QString BestSuffix(const int suffixes)
+{
+    if (suffixes & SuffixPng)
+        return ".png";
+    if (suffixes & SuffixSvg)
+        return ".svg";
+    if (suffixes & SuffixXpm)
+        return ".xpm";
+
+    return QString();
+}
+
+// groups of index.theme, group name -> (key -> value)
+static const QHash<QString, QHash<QString, QString>> ReadIndexTheme(const QString &fileName)
+{
+    QHash<QString, QHash<QString, QString>> groups;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return groups;
+
+    QTextStream in(&file);
+    in.setCodec("UTF-8");
+
+    QHash<QString, QString> *group = nullptr;
+    while (!in.atEnd())
+    {
+        const QString line = in.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#'))
+            continue;
+
+        if (line.startsWith('[') && line.endsWith(']'))
+        {
+            group = &groups[line.mid(1, line.size() - 2)];
+            continue;
+        }
+
+        const int equal = line.indexOf('=');
+        if (!group || equal == -1)
+            continue;
+
+        group->insert(line.left(equal).trimmed(), line.mid(equal + 1).trimmed());
+    }
+
+    return groups;
+}
+
+static const QStringList ListValue(const QString &value)
+{
+    QStringList list;
+    for (const QString &item : value.split(',', QString::SkipEmptyParts))
+        list << item.trimmed();
+
+    return list;
+}
+
+///
+/// \brief The IconCache class reads icon-theme.cache generated by gtk-update-icon-cache
+///
+/// all numbers are big endian:
+///   Header      u16 major, u16 minor, u32 hash offset, u32 directory list offset
+///   DirList     u32 count, u32 offsets[count] of directory names
+///   Hash        u32 bucket count, u32 offsets[count] of icon chains
+///   Icon        u32 next icon offset, u32 name offset, u32 image list offset
+///   ImageList   u32 count, { u16 directory index, u16 flags, u32 image data offset }[count]
+///
+class IconCache
+{
+public:
+    static QSharedPointer<IconCache> open(const QString &themePath);
+    ~IconCache();
+
+    int directoryIndex(const QString &dirName) const;
+    int suffixes(const QByteArray &iconName, const int dirIndex) const;
+
+private:
+    IconCache() {}
+
+    inline bool valid(const quint64 offset, const quint64 length) const {return offset + length <= m_size;}
+    inline quint16 read16(const quint32 offset) const {return valid(offset, 2) ? quint16(m_data[offset] << 8 | m_data[offset + 1]) : 0;}
+    inline quint32 read32(const quint32 offset) const
+    {
+        return valid(offset, 4) ? quint32(m_data[offset]) << 24 | quint32(m_data[offset + 1]) << 16 |
+                                  quint32(m_data[offset + 2]) << 8 | quint32(m_data[offset + 3])
+                                : 0xffffffff;
+    }
+    const char *string(const quint32 offset) const;
+
+private:
+    QFile m_file;
+    const uchar *m_data = nullptr;
+    quint32 m_size = 0;
+};
+
+///
+/// \brief IconCache::open map icon-theme.cache of theme dir
+/// \return null if there is no cache, or it's older than the theme dir
+///
+QSharedPointer<IconCache> IconCache::open(const QString &themePath)
+{
+    const QFileInfo themeInfo(themePath);
+    const QFileInfo cacheInfo(themePath + "/icon-theme.cache");
+    if (!cacheInfo.isFile() || cacheInfo.lastModified() < themeInfo.lastModified())
+        return QSharedPointer<IconCache>();
+
+    QSharedPointer<IconCache> cache(new IconCache);
+    cache->m_file.setFileName(cacheInfo.absoluteFilePath());
+    if (!cache->m_file.open(QIODevice::ReadOnly) || cache->m_file.size() < 12 || cache->m_file.size() > 0x7fffffff)
+        return QSharedPointer<IconCache>();
+
+    cache->m_size = cache->m_file.size();
+    cache->m_data = cache->m_file.map(0, cache->m_size);
+    if (!cache->m_data)
+        return QSharedPointer<IconCache>();
+
+    // only version 1.0 is known
+    if (cache->read16(0) != 1 || cache->read16(2) != 0)
+        return QSharedPointer<IconCache>();
+
+    return cache;
+}
+
+IconCache::~IconCache()
+{
+    if (m_data)
+        m_file.unmap(const_cast<uchar *>(m_data));
+}
+
+int IconCache::directoryIndex(const QString &dirName) const
+{
+    const QByteArray name = dirName.toUtf8();
+    const quint32 dirListOffset = read32(8);
+    const quint32 count = read32(dirListOffset);
+    if (!valid(quint64(dirListOffset) + 4, quint64(count) * 4))
+        return -1;
+
+    for (quint32 i(0); i != count; ++i)
+    {
+        const char *dir = string(read32(dirListOffset + 4 + i * 4));
+        if (dir && name == dir)
+            return i;
+    }
+
+    return -1;
+}
+
+///
+/// \brief IconCache::suffixes find suffix flags of icon in directory, same as gtk _gtk_icon_cache_get_icon_flags()
+///
+int IconCache::suffixes(const QByteArray &iconName, const int dirIndex) const
+{
+    if (iconName.isEmpty())
+        return SuffixNone;
+
+    // same hash function as gtk icon_name_hash()
+    const signed char *p = reinterpret_cast<const signed char *>(iconName.constData());
+    quint32 hash = *p;
+    for (++p; *p; ++p)
+        hash = (hash << 5) - hash + *p;
+
+    const quint32 hashOffset = read32(4);
+    const quint32 buckets = read32(hashOffset);
+    if (!buckets || buckets == 0xffffffff)
+        return SuffixNone;
+
+    quint32 chainOffset = read32(hashOffset + 4 + 4 * (hash % buckets));
+    // a broken cache may contain loops
+    for (quint32 steps(0); chainOffset != 0xffffffff && steps != m_size; ++steps)
+    {
+        const char *name = string(read32(chainOffset + 4));
+        if (name && iconName == name)
+        {
+            const quint32 imageListOffset = read32(chainOffset + 8);
+            const quint32 images = read32(imageListOffset);
+            for (quint32 i(0); i < images && valid(quint64(imageListOffset) + 4 + 8 * i, 8); ++i)
+                if (read16(imageListOffset + 4 + 8 * i) == dirIndex)
+                    return read16(imageListOffset + 4 + 8 * i + 2) & (SuffixXpm | SuffixSvg | SuffixPng);
+
+            return SuffixNone;
+        }
+
+        chainOffset = read32(chainOffset);
+    }
+
+    return SuffixNone;
+}
+
+const char *IconCache::string(const quint32 offset) const
+{
+    if (!valid(offset, 1))
+        return nullptr;
+
+    const char *str = reinterpret_cast<const char *>(m_data + offset);
+
+    // must be terminated inside the file
+    return memchr(str, '\0', m_size - offset) ? str : nullptr;
+}
+
+int IconTheme::ThemeDir::suffixes(const QString &iconName) const
+{
+    if (cache)
+        return cache->suffixes(iconName.toUtf8(), cacheIndex);
+
+    return icons.value(iconName, SuffixNone);
+}
+
+///
+/// \brief IconTheme::ThemeDir::sizeDifference same as gtk theme_dir_size_difference()
+/// \param smaller set to true if icons in this dir are larger than size
+///
+int IconTheme::ThemeDir::sizeDifference(const int size, bool *smaller) const
+{
+    switch (type)
+    {
+    case Fixed:
+        *smaller = size < this->size;
+        return qAbs(size - this->size);
+    case Scalable:
+        *smaller = size < minSize;
+        if (size < minSize)
+            return minSize - size;
+        if (size > maxSize)
+            return size - maxSize;
+        return 0;
+    case Threshold:
+        *smaller = size < this->size - threshold;
+        if (size < this->size - threshold)
+            return this->size - threshold - size;
+        if (size > this->size + threshold)
+            return size - this->size - threshold;
+        return 0;
+    }
+
+    return 0;
+}
+
+IconTheme::IconTheme(const QString &themeName)
+    : m_themeName(themeName),
+      m_searchPaths(searchPaths())
+{
+    if (!m_themeName.isEmpty())
+        insertTheme(m_themeName);
+    insertTheme(DefaultThemeName);
+
+    loadUnthemedIcons();
+}
+
+///
+/// \brief IconTheme::lookupIcon find icon path, names are tried without the last dash-separated part if not found
+/// \return empty string if not found
+///
+const QString IconTheme::lookupIcon(const QString &iconName, const int size) const
+{
+    // "a-b-c" -> "a-b-c", "a-b", "a"
+    QStringList names;
+    names << iconName;
+    for (int dash = iconName.lastIndexOf('-'); dash > 0; dash = iconName.lastIndexOf('-', dash - 1))
+        names << iconName.left(dash);
+
+    for (const Theme &theme : m_themes)
+    {
+        for (const QString &name : names)
+        {
+            const QString path = lookupThemeIcon(theme, name, size);
+            if (!path.isEmpty())
+                return path;
+        }
+    }
+
+    for (const QString &name : names)
+    {
+        const auto it = m_unthemedIcons.constFind(name);
+        if (it == m_unthemedIcons.cend())
+            continue;
+
+        return it->path.isEmpty() ? it->svgPath : it->path;
+    }
+
+    return QString();
+}
+
+///
+/// \brief IconTheme::searchPaths base dirs of icon themes, same order as gtk2
+///
+const QStringList IconTheme::searchPaths()
+{
+    const QStringList dataDirs = QStandardPaths::standardLocations(QStandardPaths::GenericDataLocation);
+
+    QStringList paths;
+    if (!dataDirs.isEmpty())
+        paths << dataDirs.first() + "/icons";
+    paths << QDir::homePath() + "/.icons";
+    for (int i(1); i < dataDirs.size(); ++i)
+        paths << dataDirs[i] + "/icons";
+    for (int i(1); i < dataDirs.size(); ++i)
+        paths << dataDirs[i] + "/pixmaps";
+
+    return paths;
+}
+
+///
+/// \brief IconTheme::insertTheme load theme and its parents, parents are looked up after the theme itself
+///
+void IconTheme::insertTheme(const QString &themeName)
+{
+    for (const Theme &theme : m_themes)
+        if (theme.name == themeName)
+            return;
+
+    // first index.theme in search paths is used
+    QHash<QString, QHash<QString, QString>> groups;
+    for (const QString &searchPath : m_searchPaths)
+    {
+        const QString indexFile = searchPath + "/" + themeName + "/index.theme";
+        if (!QFile::exists(indexFile))
+            continue;
+
+        groups = ReadIndexTheme(indexFile);
+        break;
+    }
+
+    const QHash<QString, QString> themeGroup = groups.value("Icon Theme");
+    if (themeGroup.isEmpty())
+        return;
+
+    // same theme may be installed in several search paths, icons in all of them are used
+    QStringList themePaths;
+    QList<QSharedPointer<IconCache>> caches;
+    for (const QString &searchPath : m_searchPaths)
+    {
+        const QString themePath = searchPath + "/" + themeName;
+        if (!QFileInfo(themePath).isDir())
+            continue;
+
+        themePaths << themePath;
+        caches << IconCache::open(themePath);
+    }
+
+    Theme theme;
+    theme.name = themeName;
+
+    for (const QString &dirName : ListValue(themeGroup.value("Directories")))
+    {
+        const QHash<QString, QString> dirGroup = groups.value(dirName);
+
+        bool ok = false;
+        const int size = dirGroup.value("Size").toInt(&ok);
+        if (!ok)
+            continue;
+
+        const QString type = dirGroup.value("Type", "Threshold");
+
+        ThemeDir dir;
+        dir.type = type == "Fixed" ? ThemeDir::Fixed : type == "Scalable" ? ThemeDir::Scalable : ThemeDir::Threshold;
+        dir.size = size;
+        dir.minSize = dirGroup.contains("MinSize") ? dirGroup.value("MinSize").toInt() : size;
+        dir.maxSize = dirGroup.contains("MaxSize") ? dirGroup.value("MaxSize").toInt() : size;
+        dir.threshold = dirGroup.contains("Threshold") ? dirGroup.value("Threshold").toInt() : 2;
+
+        for (int i(0); i != themePaths.size(); ++i)
+        {
+            dir.path = themePaths[i] + "/" + dirName;
+            dir.cache.clear();
+            dir.cacheIndex = -1;
+            dir.icons.clear();
+
+            const int cacheIndex = caches[i] ? caches[i]->directoryIndex(dirName) : -1;
+            if (cacheIndex != -1)
+            {
+                dir.cache = caches[i];
+                dir.cacheIndex = cacheIndex;
+                theme.dirs << dir;
+                continue;
+            }
+
+            if (!QFileInfo(dir.path).isDir())
+                continue;
+
+            for (const QString &fileName : QDir(dir.path).entryList(QDir::Files))
+            {
+                const int suffix = SuffixOf(fileName);
+                if (suffix != SuffixNone)
+                    dir.icons[fileName.left(fileName.size() - 4)] |= suffix;
+            }
+
+            theme.dirs << dir;
+        }
+    }
+
+    m_themes << theme;
+
+    for (const QString &parent : ListValue(themeGroup.value("Inherits")))
+        insertTheme(parent);
+}
+
+void IconTheme::loadUnthemedIcons()
+{
+    for (const QString &searchPath : m_searchPaths)
+    {
+        for (const QFileInfo &info : QDir(searchPath).entryInfoList(QDir::Files))
+        {
+            const int suffix = SuffixOf(info.fileName());
+            if (suffix == SuffixNone)
+                continue;
+
+            // first one found is used, non-svg one is preferred
+            UnthemedIcon &icon = m_unthemedIcons[info.fileName().left(info.fileName().size() - 4)];
+            QString &path = suffix == SuffixSvg ? icon.svgPath : icon.path;
+            if (path.isEmpty())
+                path = info.absoluteFilePath();
+        }
+    }
+}
+
+///
+/// \brief IconTheme::lookupThemeIcon find icon in one theme, same as gtk2 theme_lookup_icon()
+///
+/// exact size is preferred, then scalable icons cover the size, then the nearest
+/// larger icons, the nearest smaller ones are used at last.
+///
+const QString IconTheme::lookupThemeIcon(const Theme &theme, const QString &iconName, const int size) const
+{
+    const ThemeDir *minDir = nullptr;
+    const ThemeDir *matchDir = nullptr;
+    int minDifference = INT_MAX;
+    bool hasLarger = false;
+
+    for (const ThemeDir &dir : theme.dirs)
+    {
+        if (dir.suffixes(iconName) == SuffixNone)
+            continue;
+
+        bool smaller = false;
+        int difference = dir.sizeDifference(size, &smaller);
+
+        if (difference == 0)
+        {
+            if (dir.type == ThemeDir::Scalable)
+            {
+                // don't pick scalable if we already found a matching non-scalable dir
+                if (!matchDir)
+                {
+                    minDir = &dir;
+                    break;
+                }
+            } else {
+                // for a matching non-scalable dir keep going and look for a closer match
+                difference = qAbs(size - dir.size);
+                if (!matchDir || difference < minDifference)
+                {
+                    matchDir = &dir;
+                    minDifference = difference;
+                }
+                if (difference == 0)
+                    break;
+            }
+        }
+
+        if (matchDir)
+            continue;
+
+        if (!hasLarger)
+        {
+            if (difference < minDifference || smaller)
+            {
+                minDifference = difference;
+                minDir = &dir;
+                hasLarger = smaller;
+            }
+        } else if (difference < minDifference && smaller) {
+            minDifference = difference;
+            minDir = &dir;
+        }
+    }
+
+    if (matchDir)
+        minDir = matchDir;
+
+    if (!minDir)
+        return QString();
+
+    return minDir->path + "/" + iconName + BestSuffix(minDir->suffixes(iconName));
+}
@@ -0,0 +1,82 @@
+#ifndef ICONTHEME_H
+#define ICONTHEME_H
+
+#include <QHash>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class IconCache;
+
+///
+/// \brief The IconTheme class resolves icon names to file paths by freedesktop icon theme spec
+///
+/// the theme and its Inherits chain (plus hicolor) are loaded once, every theme
+/// directory is indexed in memory, from the mmapped icon-theme.cache if it's up
+/// to date, or by listing the directory. lookup follows gtk2's
+/// gtk_icon_theme_lookup_icon() with GTK_ICON_LOOKUP_GENERIC_FALLBACK, so both
+/// backends resolve the same paths.
+///
+/// not thread safe, use it in GUI thread only.
+///
+class IconTheme
+{
+public:
+    explicit IconTheme(const QString &themeName);
+
+    inline const QString &themeName() const {return m_themeName;}
+    const QString lookupIcon(const QString &iconName, const int size) const;
+
+    static const QStringList searchPaths();
+
+private:
+    struct ThemeDir {
+        enum Type {
+            Fixed,
+            Scalable,
+            Threshold,
+        };
+
+        QString path;
+        Type type;
+        int size;
+        int minSize;
+        int maxSize;
+        int threshold;
+
+        // index in icon-theme.cache, or -1 if icons are listed in this->icons
+        int cacheIndex;
+        QSharedPointer<IconCache> cache;
+        // icon name -> suffix flags
+        QHash<QString, int> icons;
+
+        int suffixes(const QString &iconName) const;
+        int sizeDifference(const int size, bool *smaller) const;
+    };
+
+    struct Theme {
+        QString name;
+        QVector<ThemeDir> dirs;
+    };
+
+    struct UnthemedIcon {
+        QString path;
+        QString svgPath;
+    };
+
+    void insertTheme(const QString &themeName);
+    void loadUnthemedIcons();
+    const QString lookupThemeIcon(const Theme &theme, const QString &iconName, const int size) const;
+
+private:
+    const QString m_themeName;
+    const QStringList m_searchPaths;
+
+    // inheritance chain, in lookup order
+    QVector<Theme> m_themes;
+    // icons directly in search paths, e.g. /usr/share/pixmaps
+    QHash<QString, UnthemedIcon> m_unthemedIcons;
+};
+
+#endif // ICONTHEME_H
@@ -0,0 +1,67 @@
+#include "perftrace.h"
+
+#ifdef WITH_PERF_TRACE
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QHash>
+#include <QList>
+
+#include <algorithm>
+
+struct PerfTraceStat {
+    quint64 calls = 0;
+    qint64 totalNs = 0;
+    qint64 maxNs = 0;
+};
+
+static QHash<QByteArray, PerfTraceStat> *perfTraceStats()
+{
+    static QHash<QByteArray, PerfTraceStat> stats;
+    return &stats;
+}
+
+static void dumpPerfTraceStats()
+{
+    const QHash<QByteArray, PerfTraceStat> *stats = perfTraceStats();
+    QList<QByteArray> names = stats->keys();
+    std::sort(names.begin(), names.end(), [stats] (const QByteArray &n1, const QByteArray &n2) {
+        return stats->value(n1).totalNs > stats->value(n2).totalNs;
+    });
+
+    qDebug() << "perf trace summary";
+    for (const QByteArray &name : names)
+    {
+        const PerfTraceStat &stat = (*stats)[name];
+        qDebug().nospace() << name.constData()
+                           << ": calls " << stat.calls
+                           << ", total " << stat.totalNs / 1000000.0 << "ms"
+                           << ", avg " << stat.totalNs / 1000.0 / stat.calls << "us"
+                           << ", max " << stat.maxNs / 1000.0 << "us";
+    }
+}
+
+PerfTrace::PerfTrace(const char *name) :
+    m_name(name)
+{
+    static bool registered = false;
+    if (!registered)
+    {
+        registered = true;
+        qAddPostRoutine(dumpPerfTraceStats);
+    }
+
+    m_timer.start();
+}
+
+PerfTrace::~PerfTrace()
+{
+    const qint64 elapsed = m_timer.nsecsElapsed();
+
+    PerfTraceStat &stat = (*perfTraceStats())[QByteArray::fromRawData(m_name, qstrlen(m_name))];
+    ++stat.calls;
+    stat.totalNs += elapsed;
+    stat.maxNs = qMax(stat.maxNs, elapsed);
+}
+
+#endif // WITH_PERF_TRACE
@@ -0,0 +1,39 @@
+#ifndef PERFTRACE_H
+#define PERFTRACE_H
+
+///
+/// scoped timers for hot paths, only compiled in with `qmake WITH_PERF_TRACE=1`.
+///
+/// PERF_TRACE("name") measures the enclosing scope, calls with the same name are
+/// accumulated and a summary (calls, total, average and max time) is printed
+/// when application quits.
+///
+/// timers are not thread safe, use them in GUI thread only.
+///
+
+#ifdef WITH_PERF_TRACE
+
+#include <QElapsedTimer>
+
+class PerfTrace
+{
+public:
+    explicit PerfTrace(const char *name);
+    ~PerfTrace();
+
+private:
+    const char *m_name;
+    QElapsedTimer m_timer;
+};
+
+#define PERF_TRACE_CONCAT_(a, b) a##b
+#define PERF_TRACE_CONCAT(a, b) PERF_TRACE_CONCAT_(a, b)
+#define PERF_TRACE(name) PerfTrace PERF_TRACE_CONCAT(perfTrace_, __LINE__)(name)
+
+#else
+
+#define PERF_TRACE(name)
+
+#endif // WITH_PERF_TRACE
+
+#endif // PERFTRACE_H
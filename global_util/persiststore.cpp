@@ -0,0 +1,166 @@
+#include "persiststore.h"
+
+#include <QTimer>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <QDebug>
+
+// files are written after no write in this interval
+static const int FlushDelay = 2000;
+
+PersistStore *PersistStore::INSTANCE = nullptr;
+
+PersistStore *PersistStore::instance(QObject *parent)
+{
+    if (!INSTANCE)
+        INSTANCE = new PersistStore(parent);
+
+    return INSTANCE;
+}
+
+PersistStore::PersistStore(QObject *parent) :
+    QObject(parent),
+    m_flushTimer(new QTimer(this))
+{
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(FlushDelay);
+
+    connect(m_flushTimer, &QTimer::timeout, this, &PersistStore::flush);
+}
+
+///
+/// \brief PersistStore::write queue data of file, replace the queued data of the same file
+///
+void PersistStore::write(const QString &fileName, const QByteArray &data)
+{
+    ++m_stats.writes;
+
+    m_pending.insert(fileName, data);
+    m_flushTimer->start();
+}
+
+///
+/// \brief PersistStore::read read file content, including data not written yet
+///
+const QByteArray PersistStore::read(const QString &fileName) const
+{
+    const auto pending = m_pending.constFind(fileName);
+    if (pending != m_pending.cend())
+        return pending.value();
+
+    const auto flushing = m_flushing.constFind(fileName);
+    if (flushing != m_flushing.cend())
+        return flushing.value();
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+
+    return file.readAll();
+}
+
+///
+/// \brief PersistStore::flush write queued files in worker thread
+///
+void PersistStore::flush()
+{
+    m_flushTimer->stop();
+
+    if (m_pending.isEmpty())
+        return;
+
+    // one batch at a time, so files are written in order. try again when it's finished
+    if (m_flushFuture.isRunning())
+        return m_flushTimer->start();
+
+    m_flushing = m_pending;
+    m_pending.clear();
+
+    QFutureWatcher<FlushResult> *watcher = new QFutureWatcher<FlushResult>(this);
+    connect(watcher, &QFutureWatcher<FlushResult>::finished, this, [=] {
+        watcher->deleteLater();
+
+        // already handled in sync()
+        if (m_flushing.isEmpty())
+            return;
+
+        m_flushing.clear();
+        flushed(watcher->result());
+    });
+
+    m_flushFuture = QtConcurrent::run(&PersistStore::writeFiles, m_flushing);
+    watcher->setFuture(m_flushFuture);
+}
+
+///
+/// \brief PersistStore::sync write all queued files and wait until they are written, used before quit
+///
+void PersistStore::sync()
+{
+    m_flushTimer->stop();
+
+    if (m_flushFuture.isRunning() || !m_flushing.isEmpty())
+    {
+        m_flushFuture.waitForFinished();
+        m_flushing.clear();
+        flushed(m_flushFuture.result());
+    }
+
+    if (!m_pending.isEmpty())
+    {
+        const QHash<QString, QByteArray> files = m_pending;
+        m_pending.clear();
+        flushed(writeFiles(files));
+    }
+
+#ifdef WITH_PERF_TRACE
+    qDebug().nospace() << "persist store: writes " << m_stats.writes
+                       << ", flushes " << m_stats.flushes
+                       << ", files " << m_stats.files
+                       << ", failures " << m_stats.failures
+                       << ", " << m_stats.bytes << " bytes"
+                       << ", " << m_stats.flushTime << "ms";
+#endif
+}
+
+// this function runs in worker threads.
+PersistStore::FlushResult PersistStore::writeFiles(const QHash<QString, QByteArray> &files)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    FlushResult result;
+    for (auto it(files.cbegin()); it != files.cend(); ++it)
+    {
+        QDir().mkpath(QFileInfo(it.key()).absolutePath());
+
+        QSaveFile file(it.key());
+        if (!file.open(QIODevice::WriteOnly) || file.write(it.value()) != it.value().size() || !file.commit())
+        {
+            qWarning() << "write file failed" << it.key() << file.errorString();
+            ++result.failures;
+            continue;
+        }
+
+        ++result.files;
+        result.bytes += it.value().size();
+    }
+
+    result.elapsed = timer.elapsed();
+
+    return result;
+}
+
+void PersistStore::flushed(const FlushResult &result)
+{
+    ++m_stats.flushes;
+    m_stats.files += result.files;
+    m_stats.failures += result.failures;
+    m_stats.bytes += result.bytes;
+    m_stats.flushTime += result.elapsed;
+}
@@ -0,0 +1,74 @@
+#ifndef PERSISTSTORE_H
+#define PERSISTSTORE_H
+
+#include <QObject>
+#include <QHash>
+#include <QByteArray>
+#include <QFuture>
+
+class QTimer;
+
+///
+/// \brief The PersistStore class writes files behind, batched and off the GUI thread
+///
+/// write() only keeps the data in memory, the last data of each file is written
+/// when there is no write for a while. files are written in a worker thread by
+/// QSaveFile, so a file is replaced atomically (temp file + rename) or kept
+/// untouched. call sync() before application quits to write everything left.
+///
+/// use it in GUI thread only.
+///
+class PersistStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats {
+        // write() calls
+        int writes = 0;
+        // batches written by worker or sync()
+        int flushes = 0;
+        // files written, less than writes if writes are merged
+        int files = 0;
+        int failures = 0;
+        qint64 bytes = 0;
+        // total time spent in writing, ms
+        qint64 flushTime = 0;
+    };
+
+    static PersistStore *instance(QObject *parent = nullptr);
+
+    void write(const QString &fileName, const QByteArray &data);
+    const QByteArray read(const QString &fileName) const;
+    inline const Stats &stats() const {return m_stats;}
+
+public slots:
+    void flush();
+    void sync();
+
+private:
+    explicit PersistStore(QObject *parent);
+
+    struct FlushResult {
+        int files = 0;
+        int failures = 0;
+        qint64 bytes = 0;
+        qint64 elapsed = 0;
+    };
+
+    static FlushResult writeFiles(const QHash<QString, QByteArray> &files);
+    void flushed(const FlushResult &result);
+
+private:
+    QTimer *m_flushTimer;
+    // file name -> data not written yet
+    QHash<QString, QByteArray> m_pending;
+    // files being written by worker, readers should see them before they are on disk
+    QHash<QString, QByteArray> m_flushing;
+    QFuture<FlushResult> m_flushFuture;
+    Stats m_stats;
+
+    static PersistStore *INSTANCE;
+};
+
+#endif // PERSISTSTORE_H
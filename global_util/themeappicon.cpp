@@ -1,22 +1,72 @@
 #include "themeappicon.h"
+#include "icontheme.h"
+#include "perftrace.h"
+#include "persiststore.h"
 #include <QFile>
 #include <QPainter>
 #include <QSvgRenderer>
 #include <QPixmap>
 #include <QDir>
 #include <QDebug>
+#include <QHash>
+#include <QDataStream>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QStandardPaths>
+#include <QApplication>
+
+#ifdef WITH_NATIVE_ICON_THEME
+#include <QGSettings>
+#endif
 
 #undef signals
 extern "C" {
     #include <string.h>
+#ifndef WITH_NATIVE_ICON_THEME
     #include <gtk/gtk.h>
+#endif
     #include <gio/gdesktopappinfo.h>
 }
 #define signals public
 
 
+#ifdef WITH_NATIVE_ICON_THEME
+static IconTheme* them = NULL;
+static QGSettings* AppearanceSettings = NULL;
+#else
 static GtkIconTheme* them = NULL;
+#endif
+
+static const quint32 IconPathsMagic = 0x50494444; // "DDIP"
+static const quint32 IconPathsFormatVersion = 1;
+// paths resolved by different backends are not shared
+#ifdef WITH_NATIVE_ICON_THEME
+static const quint32 IconPathsBackend = 1;
+#else
+static const quint32 IconPathsBackend = 0;
+#endif
+// theme dirs are checked again after this interval, same as gtk does
+static const int ThemeDirsCheckInterval = 5000;
+
+// (theme name, size, icon name) -> icon path, empty path means icon not found.
+// all of these are used in GUI thread only.
+static QHash<QString, QString> IconPaths;
+static QHash<QString, qint64> ThemeDirStamps;
+static QString ThemeName;
+static bool IconPathsLoaded = false;
+static bool IconPathsDirty = false;
+static QElapsedTimer ThemeDirsCheckTimer;
+
+#ifdef WITH_NATIVE_ICON_THEME
+// gtk-icon-theme-name is set from this key by xsettings daemon
+static const QString GetIconThemeName() {
+    if (AppearanceSettings == NULL)
+        AppearanceSettings = new QGSettings("com.deepin.dde.appearance", "", qApp);
 
+    return AppearanceSettings->get("icon-theme").toString();
+}
+#else
 inline char* get_icon_theme_name()
 {
     GtkSettings* gs = gtk_settings_get_default();
@@ -25,14 +75,96 @@ inline char* get_icon_theme_name()
     return name;
 }
 
+static const QString GetIconThemeName() {
+    char* icon_theme_name = get_icon_theme_name();
+    const QString themeName = QString::fromUtf8(icon_theme_name);
+    g_free(icon_theme_name);
+
+    return themeName;
+}
+#endif
+
+static inline const QString IconPathKey(const QString &iconName, const int size) {
+    return QString("%1/%2/%3").arg(ThemeName).arg(size).arg(iconName);
+}
+
+static const QString IconPathsFileName() {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/icon-theme-paths";
+}
+
+// last modified time of icon base dirs and theme dirs, icon-theme.cache is rewritten in
+// theme dir when icons are installed, so theme dir is changed too.
+static const QHash<QString, qint64> GetThemeDirStamps() {
+    QHash<QString, qint64> stamps;
+    for (const QString &baseDir : IconTheme::searchPaths()) {
+        const QFileInfo baseInfo(baseDir);
+        if (!baseInfo.isDir()) continue;
+
+        stamps.insert(baseDir, baseInfo.lastModified().toMSecsSinceEpoch());
+        for (const QFileInfo &info : QDir(baseDir).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot))
+            stamps.insert(info.absoluteFilePath(), info.lastModified().toMSecsSinceEpoch());
+    }
+
+    return stamps;
+}
+
+static void LoadIconPaths() {
+    IconPathsLoaded = true;
+    ThemeDirStamps = GetThemeDirStamps();
+    ThemeDirsCheckTimer.start();
+
+    const QByteArray data = PersistStore::instance()->read(IconPathsFileName());
+    if (data.isEmpty()) return;
+
+    quint32 magic = 0;
+    quint32 formatVersion = 0;
+    quint32 backend = 0;
+    QString version;
+    QHash<QString, qint64> stamps;
+    QHash<QString, QString> paths;
+
+    QDataStream in(data);
+    in >> magic >> formatVersion >> backend >> version;
+    if (magic != IconPathsMagic || formatVersion != IconPathsFormatVersion || backend != IconPathsBackend ||
+            version != qApp->applicationVersion())
+        return;
+
+    in >> stamps >> paths;
+    if (in.status() != QDataStream::Ok || stamps != ThemeDirStamps)
+        return;
+
+    IconPaths = paths;
+}
+
+// drop all paths if icons are installed or removed since last check
+static void CheckThemeDirs() {
+    if (ThemeDirsCheckTimer.isValid() && ThemeDirsCheckTimer.elapsed() < ThemeDirsCheckInterval) return;
+    ThemeDirsCheckTimer.start();
+
+    const QHash<QString, qint64> stamps = GetThemeDirStamps();
+    if (stamps == ThemeDirStamps) return;
+
+    ThemeDirStamps = stamps;
+    IconPaths.clear();
+    IconPathsDirty = true;
+
+#ifdef WITH_NATIVE_ICON_THEME
+    // directory index of native theme is outdated
+    delete them;
+    them = NULL;
+#endif
+}
+
 ThemeAppIcon::ThemeAppIcon(QObject *parent) : QObject(parent)
 {
 
 }
 
 void ThemeAppIcon::gtkInit(){
+#ifndef WITH_NATIVE_ICON_THEME
     gtk_init(NULL, NULL);
     gdk_error_trap_push();
+#endif
 }
 
 QPixmap ThemeAppIcon::getIconPixmap(QString iconPath, int width, int height){
@@ -73,6 +205,46 @@ QPixmap ThemeAppIcon::getIconPixmap(QString iconPath, int width, int height){
     return pixmap;
 }
 
+///
+/// \brief ThemeAppIcon::refreshThemeIconPaths read icon theme name again and drop cached paths,
+/// called when gtk icon theme is changed
+///
+void ThemeAppIcon::refreshThemeIconPaths()
+{
+    if (!IconPathsLoaded) LoadIconPaths();
+
+    const QString themeName = GetIconThemeName();
+
+#ifdef WITH_NATIVE_ICON_THEME
+    // theme is reloaded on next lookup
+    delete them;
+    them = NULL;
+#else
+    // setting custom theme resets internal state of gtk icon theme, only do it when name is changed
+    if (them != NULL && themeName != ThemeName)
+        gtk_icon_theme_set_custom_theme(them, themeName.toUtf8().constData());
+#endif
+
+    ThemeName = themeName;
+    ThemeDirStamps = GetThemeDirStamps();
+    ThemeDirsCheckTimer.start();
+    IconPaths.clear();
+    IconPathsDirty = true;
+}
+
+void ThemeAppIcon::saveThemeIconPaths()
+{
+    if (!IconPathsDirty) return;
+
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out << IconPathsMagic << IconPathsFormatVersion << IconPathsBackend << qApp->applicationVersion();
+    out << ThemeDirStamps << IconPaths;
+
+    PersistStore::instance()->write(IconPathsFileName(), data);
+    IconPathsDirty = false;
+}
+
 QString ThemeAppIcon::getThemeIconPath(QString iconName, int size)
 {
     QByteArray bytes = iconName.toUtf8();
@@ -81,6 +253,27 @@ QString ThemeAppIcon::getThemeIconPath(QString iconName, int size)
     if (g_path_is_absolute(name))
             return g_strdup(name);
 
+        if (!IconPathsLoaded)
+            LoadIconPaths();
+        else
+            CheckThemeDirs();
+
+        if (them == NULL) {
+            ThemeName = GetIconThemeName();
+#ifdef WITH_NATIVE_ICON_THEME
+            them = new IconTheme(ThemeName);
+#else
+            // In pratice, default icon theme may not gets the right icon path when program starting.
+            them = gtk_icon_theme_new();
+            gtk_icon_theme_set_custom_theme(them, ThemeName.toUtf8().constData());
+#endif
+        }
+
+        const QString cacheKey = IconPathKey(iconName, size);
+        const auto cached = IconPaths.constFind(cacheKey);
+        if (cached != IconPaths.cend())
+            return cached.value();
+
         g_return_val_if_fail(name != NULL, NULL);
 
         int pic_name_len = strlen(name);
@@ -92,21 +285,22 @@ QString ThemeAppIcon::getThemeIconPath(QString iconName, int size)
             }
         }
 
-        // In pratice, default icon theme may not gets the right icon path when program starting.
-        if (them == NULL)
-            them = gtk_icon_theme_new();
-        char* icon_theme_name = get_icon_theme_name();
-        gtk_icon_theme_set_custom_theme(them, icon_theme_name);
-        g_free(icon_theme_name);
+        PERF_TRACE("ThemeAppIcon::getThemeIconPath");
 
         char* pic_name = g_strndup(name, pic_name_len);
 
+#ifdef WITH_NATIVE_ICON_THEME
+        const QString iconPath = them->lookupIcon(QString::fromUtf8(pic_name), size);
+        g_free(pic_name);
+#else
         GtkIconInfo* info = gtk_icon_theme_lookup_icon(them, pic_name, size, GTK_ICON_LOOKUP_GENERIC_FALLBACK);
         if (info == NULL) {
             info = gtk_icon_theme_lookup_icon(gtk_icon_theme_get_default(), pic_name, size, GTK_ICON_LOOKUP_GENERIC_FALLBACK);
             if (info == NULL) {
 //                qWarning() << "get gtk icon theme info failed for" << pic_name;
                 g_free(pic_name);
+                IconPaths.insert(cacheKey, QString());
+                IconPathsDirty = true;
                 return "";
             }
         }
@@ -120,7 +314,15 @@ QString ThemeAppIcon::getThemeIconPath(QString iconName, int size)
         gtk_icon_info_free(info);
     #endif
         g_debug("get icon from icon theme is: %s", path);
-        return path;
+
+        const QString iconPath = QString::fromUtf8(path);
+        g_free(path);
+#endif
+
+        IconPaths.insert(cacheKey, iconPath);
+        IconPathsDirty = true;
+
+        return iconPath;
 }
 
 
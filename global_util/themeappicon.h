@@ -14,6 +14,8 @@ public:
 
     static QPixmap getIconPixmap(QString iconPath, int width=64, int height=64);
     static QString getThemeIconPath(QString iconName, int size=64);
+    static void refreshThemeIconPaths();
+    static void saveThemeIconPaths();
 
 signals:
 
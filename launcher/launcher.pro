@@ -0,0 +1,59 @@
+QT      += core gui dbus widgets x11extras svg concurrent
+
+TARGET = dde-launcher
+TEMPLATE = app
+CONFIG += c++11 link_pkgconfig
+PKGCONFIG += dtkbase dtkwidget dtkutil xcb xcb-ewmh\
+          gsettings-qt gtk+-2.0 gio-unix-2.0 dframeworkdbus
+
+ROOT = $$PWD/..
+INCLUDEPATH += $$ROOT
+
+include($$ROOT/feature-macros.pri)
+include($$ROOT/widgets/widgets.pri)
+include($$ROOT/boxframe/boxframe.pri)
+include($$ROOT/dbusinterface/dbusinterface.pri)
+include($$ROOT/global_util/global_util.pri)
+include($$ROOT/model/model.pri)
+include($$ROOT/delegate/delegate.pri)
+
+ARCH = $$QMAKE_HOST.arch
+isEqual(ARCH, mips64) | isEqual(ARCH, mips32) {
+    DEFINES += ARCH_MIPSEL
+}
+
+SOURCES += \
+    $$ROOT/mainframe.cpp \
+    $$ROOT/view/applistview.cpp \
+    $$ROOT/view/appgridview.cpp \
+    $$ROOT/worker/menuworker.cpp \
+    $$ROOT/dbusservices/dbuslauncherservice.cpp \
+    $$ROOT/main.cpp
+
+HEADERS += \
+    $$ROOT/mainframe.h \
+    $$ROOT/view/applistview.h \
+    $$ROOT/view/appgridview.h \
+    $$ROOT/worker/menuworker.h \
+    $$ROOT/dbusservices/dbuslauncherservice.h
+
+#Automating generation .qm files from .ts files
+system(cd $$ROOT && ./translate_generation.sh)
+
+target.path = /usr/bin
+
+data_files.files = $$ROOT/data/*
+data_files.path = /usr/share/dde-launcher/data
+
+qm_files.files = $$ROOT/translations/*.qm
+qm_files.path = /usr/share/dde-launcher/translations
+
+services.path = /usr/share/dbus-1/services
+services.files = $$ROOT/dbusservices/com.deepin.dde.Launcher.service
+
+INSTALLS += target qm_files services data_files
+
+RESOURCES += \
+    $$ROOT/skin.qrc
+
+DISTFILES += $$ROOT/data/*
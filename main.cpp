@@ -1,5 +1,9 @@
 
+#ifdef WITH_NATIVE_ICON_THEME
+#include <QGSettings>
+#else
 #include <gtk/gtk.h>
+#endif
 
 #include "mainframe.h"
 #include "dbuslauncherframe.h"
@@ -15,6 +19,7 @@
 DWIDGET_USE_NAMESPACE
 DUTIL_USE_NAMESPACE
 
+#ifndef WITH_NATIVE_ICON_THEME
 #define PROP_GTK_ICON_THEME_NAME     "gtk-icon-theme-name"
 
 void iconThemeChanged(GtkSettings *gsettings, GParamSpec *pspec, gpointer udata)
@@ -25,6 +30,7 @@ void iconThemeChanged(GtkSettings *gsettings, GParamSpec *pspec, gpointer udata)
 
     AppsManager::instance()->refreshAppIconCache();
 }
+#endif
 
 int main(int argv, char *args[])
 {
@@ -94,9 +100,18 @@ int main(int argv, char *args[])
 #endif
         launcher.show();
 
+#ifdef WITH_NATIVE_ICON_THEME
+    // monitor icon theme changed
+    QGSettings appearanceSettings("com.deepin.dde.appearance");
+    QObject::connect(&appearanceSettings, &QGSettings::changed, [] (const QString &key) {
+        if (key == "iconTheme")
+            AppsManager::instance()->refreshAppIconCache();
+    });
+#else
     // monitor gtk icon theme changed
     GtkSettings *gs = gtk_settings_get_default();
     g_signal_connect(gs, "notify::" PROP_GTK_ICON_THEME_NAME, G_CALLBACK(iconThemeChanged), NULL);
+#endif
 
     return app.exec();
 }
@@ -2,6 +2,7 @@
 #include "mainframe.h"
 #include "global_util/constants.h"
 #include "global_util/xcb_misc.h"
+#include "global_util/perftrace.h"
 #include "backgroundmanager.h"
 
 #include <QApplication>
@@ -32,6 +33,7 @@ MainFrame::MainFrame(QWidget *parent) :
     m_appsManager(AppsManager::instance(this)),
     m_delayHideTimer(new QTimer(this)),
     m_autoScrollTimer(new QTimer(this)),
+    m_standbyTimer(new QTimer(this)),
     m_navigationWidget(new NavigationWidget),
     m_rightSpacing(new QWidget),
     m_searchWidget(new SearchWidget(this)),
@@ -45,45 +47,13 @@ MainFrame::MainFrame(QWidget *parent) :
     m_bottomGradient(new GradientLabel(this)),
 
     m_allAppsView(new AppListView),
-    m_internetView(new AppListView),
-    m_chatView(new AppListView),
-    m_musicView(new AppListView),
-    m_videoView(new AppListView),
-    m_graphicsView(new AppListView),
-    m_gameView(new AppListView),
-    m_officeView(new AppListView),
-    m_readingView(new AppListView),
-    m_developmentView(new AppListView),
-    m_systemView(new AppListView),
-    m_othersView(new AppListView),
+    m_categoryView(new AppGridView),
 
     m_allAppsModel(new AppsListModel(AppsListModel::All)),
     m_searchResultModel(new AppsListModel(AppsListModel::Search)),
-    m_internetModel(new AppsListModel(AppsListModel::Internet)),
-    m_chatModel(new AppsListModel(AppsListModel::Chat)),
-    m_musicModel(new AppsListModel(AppsListModel::Music)),
-    m_videoModel(new AppsListModel(AppsListModel::Video)),
-    m_graphicsModel(new AppsListModel(AppsListModel::Graphics)),
-    m_gameModel(new AppsListModel(AppsListModel::Game)),
-    m_officeModel(new AppsListModel(AppsListModel::Office)),
-    m_readingModel(new AppsListModel(AppsListModel::Reading)),
-    m_developmentModel(new AppsListModel(AppsListModel::Development)),
-    m_systemModel(new AppsListModel(AppsListModel::System)),
-    m_othersModel(new AppsListModel(AppsListModel::Others)),
-
-
-    m_floatTitle(new CategoryTitleWidget("Internet", this)),
-    m_internetTitle(new CategoryTitleWidget("Internet")),
-    m_chatTitle(new CategoryTitleWidget("Chat")),
-    m_musicTitle(new CategoryTitleWidget("Music")),
-    m_videoTitle(new CategoryTitleWidget("Video")),
-    m_graphicsTitle(new CategoryTitleWidget("Graphics")),
-    m_gameTitle(new CategoryTitleWidget("Game")),
-    m_officeTitle(new CategoryTitleWidget("Office")),
-    m_readingTitle(new CategoryTitleWidget("Reading")),
-    m_developmentTitle(new CategoryTitleWidget("Development")),
-    m_systemTitle(new CategoryTitleWidget("System")),
-    m_othersTitle(new CategoryTitleWidget("Others"))
+    m_categoryModel(new GroupedAppsModel),
+
+    m_floatTitle(new CategoryTitleWidget("Internet", this))
 {
     setFocusPolicy(Qt::ClickFocus);
     setWindowFlags(Qt::FramelessWindowHint | Qt::SplashScreen);
@@ -96,6 +66,8 @@ MainFrame::MainFrame(QWidget *parent) :
     updateDisplayMode(getDisplayMode());
 
     setStyleSheet(getQssFromFile(":/skin/qss/main.qss"));
+
+    m_standbyTimer->start();
 }
 
 void MainFrame::exit()
@@ -118,21 +90,32 @@ int MainFrame::dockPosition()
     return m_appsManager->dockPosition();
 }
 
+///
+/// \brief MainFrame::startShowTiming start measuring show latency, it's stopped when first frame is painted
+///
+void MainFrame::startShowTiming()
+{
+    if (isVisible())
+        return;
+
+    m_showTimer.start();
+}
+
 void MainFrame::scrollToCategory(const AppsListModel::AppCategory &category)
 {
-    QWidget *dest = categoryView(category);
+    const int dest = categoryScrollOffset(category);
 
-    if (!dest)
+    if (dest == -1)
         return;
 
     m_currentCategory = category;
 
     // scroll to destination
-//    m_appsArea->verticalScrollBar()->setValue(dest->pos().y());
-    m_scrollDest = dest;
+//    m_appsArea->verticalScrollBar()->setValue(dest);
+    m_scrollDest = category;
     m_scrollAnimation->stop();
     m_scrollAnimation->setStartValue(m_appsArea->verticalScrollBar()->value());
-    m_scrollAnimation->setEndValue(dest->y());
+    m_scrollAnimation->setEndValue(dest);
     m_scrollAnimation->start();
 }
 
@@ -234,24 +217,42 @@ void MainFrame::keyPressEvent(QKeyEvent *e)
 
 void MainFrame::showEvent(QShowEvent *e)
 {
+    PERF_TRACE("MainFrame::showEvent");
+
     m_delayHideTimer->stop();
-    m_searchWidget->clearSearchContent();
-    updateCurrentVisibleCategory();
-    // TODO: Do we need this in showEvent ???
-    XcbMisc::instance()->set_deepin_override(winId());
-    // To make sure the window is placed at the right position.
-    updateGeometry();
+    m_standbyTimer->stop();
+
+    // window is not prepared when it's shown right after hidden, do it now
+    const bool standbyReady = m_standbyReady;
+    if (!standbyReady)
+    {
+        m_searchWidget->clearSearchContent();
+        updateCurrentVisibleCategory();
+        // TODO: Do we need this in showEvent ???
+        XcbMisc::instance()->set_deepin_override(winId());
+        // To make sure the window is placed at the right position.
+        updateGeometry();
+    }
 
     QFrame::showEvent(e);
 
-    QTimer::singleShot(0, this, [this] () {
-        showGradient();
+    QTimer::singleShot(0, this, [=] () {
+        if (!standbyReady)
+            showGradient();
         raise();
         activateWindow();
         m_floatTitle->raise();
     });
 }
 
+void MainFrame::hideEvent(QHideEvent *e)
+{
+    QFrame::hideEvent(e);
+
+    m_showTimer.invalidate();
+    scheduleStandby();
+}
+
 void MainFrame::mouseReleaseEvent(QMouseEvent *e)
 {
     QFrame::mouseReleaseEvent(e);
@@ -288,6 +289,10 @@ void MainFrame::paintEvent(QPaintEvent *e)
     painter.drawPixmap(e->rect(), getBackground(), e->rect());
     //    painter.setBrush(QColor(255, 0, 0, 0.2 * 255));
     //    painter.drawRect(rect());
+
+    // children are painted and flushed after this, check it in next loop
+    if (m_showTimer.isValid() && isVisible())
+        QTimer::singleShot(0, this, &MainFrame::showFramePainted);
 }
 
 bool MainFrame::event(QEvent *e)
@@ -337,6 +342,9 @@ void MainFrame::initUI()
     m_delayHideTimer->setInterval(500);
     m_delayHideTimer->setSingleShot(true);
 
+    m_standbyTimer->setInterval(100);
+    m_standbyTimer->setSingleShot(true);
+
     m_autoScrollTimer->setInterval(DLauncher::APPS_AREA_AUTO_SCROLL_TIMER);
     m_autoScrollTimer->setSingleShot(false);
 
@@ -358,76 +366,15 @@ void MainFrame::initUI()
     m_allAppsView->setModel(m_allAppsModel);
     m_allAppsView->setItemDelegate(m_appItemDelegate);
     m_allAppsView->setContainerBox(m_appsArea);
-    m_internetView->setAccessibleName("internet");
-    m_internetView->setModel(m_internetModel);
-    m_internetView->setItemDelegate(m_appItemDelegate);
-    m_chatView->setAccessibleName("chat");
-    m_chatView->setModel(m_chatModel);
-    m_chatView->setItemDelegate(m_appItemDelegate);
-    m_musicView->setAccessibleName("music");
-    m_musicView->setModel(m_musicModel);
-    m_musicView->setItemDelegate(m_appItemDelegate);
-    m_videoView->setAccessibleName("video");
-    m_videoView->setModel(m_videoModel);
-    m_videoView->setItemDelegate(m_appItemDelegate);
-    m_graphicsView->setAccessibleName("graphics");
-    m_graphicsView->setModel(m_graphicsModel);
-    m_graphicsView->setItemDelegate(m_appItemDelegate);
-    m_gameView->setAccessibleName("game");
-    m_gameView->setModel(m_gameModel);
-    m_gameView->setItemDelegate(m_appItemDelegate);
-    m_officeView->setAccessibleName("office");
-    m_officeView->setModel(m_officeModel);
-    m_officeView->setItemDelegate(m_appItemDelegate);
-    m_readingView->setAccessibleName("reading");
-    m_readingView->setModel(m_readingModel);
-    m_readingView->setItemDelegate(m_appItemDelegate);
-    m_developmentView->setAccessibleName("development");
-    m_developmentView->setModel(m_developmentModel);
-    m_developmentView->setItemDelegate(m_appItemDelegate);
-    m_systemView->setAccessibleName("system");
-    m_systemView->setModel(m_systemModel);
-    m_systemView->setItemDelegate(m_appItemDelegate);
-    m_othersView->setAccessibleName("others");
-    m_othersView->setModel(m_othersModel);
-    m_othersView->setItemDelegate(m_appItemDelegate);
+    m_categoryView->setAccessibleName("category");
+    m_categoryView->setModel(m_categoryModel);
+    m_categoryView->setItemDelegate(m_appItemDelegate);
 
     m_floatTitle->setVisible(false);
-    m_internetTitle->setTextVisible(false);
-    m_chatTitle->setTextVisible(false);
-    m_musicTitle->setTextVisible(false);
-    m_videoTitle->setTextVisible(false);
-    m_graphicsTitle->setTextVisible(false);
-    m_gameTitle->setTextVisible(false);
-    m_officeTitle->setTextVisible(false);
-    m_readingTitle->setTextVisible(false);
-    m_developmentTitle->setTextVisible(false);
-    m_systemTitle->setTextVisible(false);
-    m_othersTitle->setTextVisible(false);
+    m_categoryView->setTitleVisible(false);
 
     m_appsVbox->layout()->addWidget(m_allAppsView);
-    m_appsVbox->layout()->addWidget(m_internetTitle);
-    m_appsVbox->layout()->addWidget(m_internetView);
-    m_appsVbox->layout()->addWidget(m_chatTitle);
-    m_appsVbox->layout()->addWidget(m_chatView);
-    m_appsVbox->layout()->addWidget(m_musicTitle);
-    m_appsVbox->layout()->addWidget(m_musicView);
-    m_appsVbox->layout()->addWidget(m_videoTitle);
-    m_appsVbox->layout()->addWidget(m_videoView);
-    m_appsVbox->layout()->addWidget(m_graphicsTitle);
-    m_appsVbox->layout()->addWidget(m_graphicsView);
-    m_appsVbox->layout()->addWidget(m_gameTitle);
-    m_appsVbox->layout()->addWidget(m_gameView);
-    m_appsVbox->layout()->addWidget(m_officeTitle);
-    m_appsVbox->layout()->addWidget(m_officeView);
-    m_appsVbox->layout()->addWidget(m_readingTitle);
-    m_appsVbox->layout()->addWidget(m_readingView);
-    m_appsVbox->layout()->addWidget(m_developmentTitle);
-    m_appsVbox->layout()->addWidget(m_developmentView);
-    m_appsVbox->layout()->addWidget(m_systemTitle);
-    m_appsVbox->layout()->addWidget(m_systemView);
-    m_appsVbox->layout()->addWidget(m_othersTitle);
-    m_appsVbox->layout()->addWidget(m_othersView);
+    m_appsVbox->layout()->addWidget(m_categoryView);
     m_appsVbox->layout()->addWidget(m_viewListPlaceholder);
     m_appsVbox->layout()->setSpacing(0);
     m_appsVbox->layout()->setContentsMargins(0, DLauncher::APPS_AREA_TOP_MARGIN,
@@ -480,13 +427,6 @@ void MainFrame::showGradient() {
                                            QPoint(0, 0));
         QSize topSize(m_appsArea->width(), DLauncher::TOP_BOTTOM_GRADIENT_HEIGHT);
         QRect topRect(topLeft, topSize);
-        m_topGradient->setPixmap(getBackground().copy(topRect));
-        m_topGradient->resize(topRect.size());
-
-//        qDebug() << "topleft point:" << topRect.topLeft() << topRect.size();
-        m_topGradient->move(topRect.topLeft());
-        m_topGradient->show();
-        m_topGradient->raise();
 
         QPoint bottomPoint = m_appsArea->mapTo(this,
                                              m_appsArea->rect().bottomLeft());
@@ -495,7 +435,25 @@ void MainFrame::showGradient() {
         QPoint bottomLeft(bottomPoint.x(), bottomPoint.y() + 1 - bottomSize.height());
 
         QRect bottomRect(bottomLeft, bottomSize);
-        m_bottomGradient->setPixmap(getBackground().copy(bottomRect));
+
+        const QPixmap background = getBackground();
+        if (background.cacheKey() != m_gradientBackgroundKey ||
+                topRect != m_topGradientRect || bottomRect != m_bottomGradientRect) {
+            m_gradientBackgroundKey = background.cacheKey();
+            m_topGradientRect = topRect;
+            m_bottomGradientRect = bottomRect;
+
+            // labels compose gradient only when pixmap is changed
+            m_topGradient->setPixmap(background.copy(topRect));
+            m_bottomGradient->setPixmap(background.copy(bottomRect));
+        }
+
+        m_topGradient->resize(topRect.size());
+
+//        qDebug() << "topleft point:" << topRect.topLeft() << topRect.size();
+        m_topGradient->move(topRect.topLeft());
+        m_topGradient->show();
+        m_topGradient->raise();
 
         m_bottomGradient->resize(bottomRect.size());
         m_bottomGradient->move(bottomRect.topLeft());
@@ -526,17 +484,7 @@ void MainFrame::refershCategoryTextVisible()
     // NOTE(hualet): don't show/hide category text with animation, it'll conflicts
     // with the zoom animation causing very strange behavior;
     m_navigationWidget->setCategoryTextVisible(!shownAppList/*, true*/);
-    m_internetTitle->setTextVisible(shownAppList, true);
-    m_chatTitle->setTextVisible(shownAppList, true);
-    m_musicTitle->setTextVisible(shownAppList, true);
-    m_videoTitle->setTextVisible(shownAppList, true);
-    m_graphicsTitle->setTextVisible(shownAppList, true);
-    m_gameTitle->setTextVisible(shownAppList, true);
-    m_officeTitle->setTextVisible(shownAppList, true);
-    m_readingTitle->setTextVisible(shownAppList, true);
-    m_developmentTitle->setTextVisible(shownAppList, true);
-    m_systemTitle->setTextVisible(shownAppList, true);
-    m_othersTitle->setTextVisible(shownAppList, true);
+    m_categoryView->setTitleVisible(shownAppList, true);
 }
 
 void MainFrame::refershCurrentFloatTitle()
@@ -544,107 +492,59 @@ void MainFrame::refershCurrentFloatTitle()
     if (m_displayMode != GroupByCategory)
         return m_floatTitle->setVisible(false);
 
-    CategoryTitleWidget *sourceTitle = categoryTitle(m_currentCategory);
-    if (!sourceTitle)
+    const QRect sourceTitle = m_categoryView->titleRect(m_currentCategory);
+    if (sourceTitle.isNull())
         return;
 
-    m_floatTitle->setFixedSize(sourceTitle->size());
-    m_floatTitle->setText(sourceTitle->textLabel()->text());
-    m_floatTitle->setVisible(sourceTitle->visibleRegion().isEmpty() ||
-                             sourceTitle->visibleRegion().boundingRect().height() < 20);
-}
-
-CategoryTitleWidget *MainFrame::categoryTitle(const AppsListModel::AppCategory category) const
-{
-    CategoryTitleWidget *dest = nullptr;
-
-    switch (category)
-    {
-    case AppsListModel::Internet:       dest = m_internetTitle;         break;
-    case AppsListModel::Chat:           dest = m_chatTitle;             break;
-    case AppsListModel::Music:          dest = m_musicTitle;            break;
-    case AppsListModel::Video:          dest = m_videoTitle;            break;
-    case AppsListModel::Graphics:       dest = m_graphicsTitle;         break;
-    case AppsListModel::Game:           dest = m_gameTitle;             break;
-    case AppsListModel::Office:         dest = m_officeTitle;           break;
-    case AppsListModel::Reading:        dest = m_readingTitle;          break;
-    case AppsListModel::Development:    dest = m_developmentTitle;      break;
-    case AppsListModel::System:         dest = m_systemTitle;           break;
-    case AppsListModel::Others:         dest = m_othersTitle;           break;
-    default:;
-    }
+    // part of title in scroll area viewport
+    const QPoint viewPos = m_categoryView->mapTo(m_appsArea->viewport(), QPoint(0, 0));
+    const QRect visibleTitle = sourceTitle.translated(viewPos).intersected(m_appsArea->viewport()->rect());
 
-    return dest;
+    m_floatTitle->setFixedSize(sourceTitle.size());
+    m_floatTitle->setText(GroupedAppsModel::categoryName(m_currentCategory));
+    m_floatTitle->setVisible(visibleTitle.isEmpty() || visibleTitle.height() < 20);
 }
 
-AppListView *MainFrame::categoryView(const AppsListModel::AppCategory category) const
+///
+/// \brief MainFrame::categoryScrollOffset scroll bar value to show category at top
+/// \return -1 if category is not shown
+///
+int MainFrame::categoryScrollOffset(const AppsListModel::AppCategory category) const
 {
-    AppListView *view = nullptr;
-
-    switch (category)
-    {
-    case AppsListModel::Internet:       view = m_internetView;      break;
-    case AppsListModel::Chat:           view = m_chatView;          break;
-    case AppsListModel::Music:          view = m_musicView;         break;
-    case AppsListModel::Video:          view = m_videoView;         break;
-    case AppsListModel::Graphics:       view = m_graphicsView;      break;
-    case AppsListModel::Game:           view = m_gameView;          break;
-    case AppsListModel::Office:         view = m_officeView;        break;
-    case AppsListModel::Reading:        view = m_readingView;       break;
-    case AppsListModel::Development:    view = m_developmentView;   break;
-    case AppsListModel::System:         view = m_systemView;        break;
-    case AppsListModel::Others:         view = m_othersView;        break;
-    default:;
-    }
-
-    return view;
-}
+    const QRect rect = m_categoryView->titleRect(category);
+    if (rect.isNull())
+        return -1;
 
-AppListView *MainFrame::lastVisibleView() const
-{
-    if (!m_appsManager->appsInfoList(AppsListModel::Others).isEmpty())
-        return m_othersView;
-    if (!m_appsManager->appsInfoList(AppsListModel::System).isEmpty())
-        return m_systemView;
-    if (!m_appsManager->appsInfoList(AppsListModel::Development).isEmpty())
-        return m_developmentView;
-    if (!m_appsManager->appsInfoList(AppsListModel::Reading).isEmpty())
-        return m_readingView;
-    if (!m_appsManager->appsInfoList(AppsListModel::Office).isEmpty())
-        return m_officeView;
-    if (!m_appsManager->appsInfoList(AppsListModel::Game).isEmpty())
-        return m_gameView;
-    if (!m_appsManager->appsInfoList(AppsListModel::Graphics).isEmpty())
-        return m_graphicsView;
-    if (!m_appsManager->appsInfoList(AppsListModel::Video).isEmpty())
-        return m_videoView;
-    if (!m_appsManager->appsInfoList(AppsListModel::Music).isEmpty())
-        return m_musicView;
-    if (!m_appsManager->appsInfoList(AppsListModel::Chat).isEmpty())
-        return m_chatView;
-    if (!m_appsManager->appsInfoList(AppsListModel::Internet).isEmpty())
-        return m_internetView;
-
-    return nullptr;
+    return m_categoryView->y() + rect.bottom() + 1;
 }
 
 void MainFrame::initConnection()
 {
     connect(m_displayInter, &DBusDisplay::PrimaryChanged, this, &MainFrame::updateGeometry);
+    connect(m_displayInter, &DBusDisplay::PrimaryChanged, this, &MainFrame::scheduleStandby);
     connect(m_displayInter, &DBusDisplay::PrimaryRectChanged, this, &MainFrame::updateGeometry);
+    connect(m_displayInter, &DBusDisplay::PrimaryRectChanged, this, &MainFrame::scheduleStandby);
 
     connect(m_calcUtil, &CalculateUtil::layoutChanged, this, &MainFrame::layoutChanged, Qt::QueuedConnection);
+    connect(m_calcUtil, &CalculateUtil::layoutChanged, this, &MainFrame::scheduleStandby, Qt::QueuedConnection);
 
     connect(m_scrollAnimation, &QPropertyAnimation::valueChanged, this, &MainFrame::ensureScrollToDest);
     connect(m_scrollAnimation, &QPropertyAnimation::finished, this, &MainFrame::refershCurrentFloatTitle, Qt::QueuedConnection);
     connect(m_navigationWidget, &NavigationWidget::scrollToCategory, this, &MainFrame::scrollToCategory);
     connect(this, &MainFrame::currentVisibleCategoryChanged, m_navigationWidget, &NavigationWidget::setCurrentCategory);
     connect(this, &MainFrame::categoryAppNumsChanged, m_navigationWidget, &NavigationWidget::refershCategoryVisible);
-    connect(this, &MainFrame::categoryAppNumsChanged, this, &MainFrame::refershCategoryVisible);
     connect(this, &MainFrame::displayModeChanged, this, &MainFrame::checkCategoryVisible);
     connect(m_searchWidget, &SearchWidget::searchTextChanged, this, &MainFrame::searchTextChanged);
     connect(m_delayHideTimer, &QTimer::timeout, this, &MainFrame::hide);
+    connect(m_standbyTimer, &QTimer::timeout, this, &MainFrame::prepareStandby);
     connect(this, &MainFrame::backgroundChanged, this, static_cast<void (MainFrame::*)()>(&MainFrame::update));
+    connect(this, &MainFrame::backgroundChanged, this, &MainFrame::scheduleStandby);
+    // a temporary background may be shown first, gradients follow the ready one
+    connect(this, &MainFrame::backgroundChanged, this, [this] {
+        if (isVisible())
+            showGradient();
+    });
+    connect(m_appsManager, &AppsManager::layoutChanged, this, &MainFrame::scheduleStandby);
 
     // auto scroll when drag to app list box border
     connect(m_allAppsView, &AppListView::requestScrollStop, m_autoScrollTimer, &QTimer::stop);
@@ -663,73 +563,23 @@ void MainFrame::initConnection()
     });
 
     connect(m_allAppsView, &AppListView::popupMenuRequested, this, &MainFrame::showPopupMenu);
-    connect(m_internetView, &AppListView::popupMenuRequested, this, &MainFrame::showPopupMenu);
-    connect(m_chatView, &AppListView::popupMenuRequested, this, &MainFrame::showPopupMenu);
-    connect(m_musicView, &AppListView::popupMenuRequested, this, &MainFrame::showPopupMenu);
-    connect(m_videoView, &AppListView::popupMenuRequested, this, &MainFrame::showPopupMenu);
-    connect(m_graphicsView, &AppListView::popupMenuRequested, this, &MainFrame::showPopupMenu);
-    connect(m_gameView, &AppListView::popupMenuRequested, this, &MainFrame::showPopupMenu);
-    connect(m_officeView, &AppListView::popupMenuRequested, this, &MainFrame::showPopupMenu);
-    connect(m_readingView, &AppListView::popupMenuRequested, this, &MainFrame::showPopupMenu);
-    connect(m_developmentView, &AppListView::popupMenuRequested, this, &MainFrame::showPopupMenu);
-    connect(m_systemView, &AppListView::popupMenuRequested, this, &MainFrame::showPopupMenu);
-    connect(m_othersView, &AppListView::popupMenuRequested, this, &MainFrame::showPopupMenu);
+    connect(m_categoryView, &AppGridView::popupMenuRequested, this, &MainFrame::showPopupMenu);
 
 //    connect(m_allAppsView, &AppListView::appBeDraged, m_appsManager, &AppsManager::handleDragedApp);
 //    connect(m_allAppsView, &AppListView::appDropedIn, m_appsManager, &AppsManager::handleDropedApp);
 //    connect(m_allAppsView, &AppListView::handleDragItems, m_appsManager, &AppsManager::handleDragedApp);
 
     connect(m_allAppsView, &AppListView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
-    connect(m_internetView, &AppListView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
-    connect(m_chatView, &AppListView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
-    connect(m_musicView, &AppListView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
-    connect(m_videoView, &AppListView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
-    connect(m_graphicsView, &AppListView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
-    connect(m_gameView, &AppListView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
-    connect(m_officeView, &AppListView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
-    connect(m_readingView, &AppListView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
-    connect(m_developmentView, &AppListView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
-    connect(m_systemView, &AppListView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
-    connect(m_othersView, &AppListView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
+    connect(m_categoryView, &AppGridView::entered, m_appItemDelegate, &AppItemDelegate::setCurrentIndex);
 
     connect(m_allAppsView, &AppListView::clicked, m_appsManager, &AppsManager::launchApp);
-    connect(m_internetView, &AppListView::clicked, m_appsManager, &AppsManager::launchApp);
-    connect(m_chatView, &AppListView::clicked, m_appsManager, &AppsManager::launchApp);
-    connect(m_musicView, &AppListView::clicked, m_appsManager, &AppsManager::launchApp);
-    connect(m_videoView, &AppListView::clicked, m_appsManager, &AppsManager::launchApp);
-    connect(m_graphicsView, &AppListView::clicked, m_appsManager, &AppsManager::launchApp);
-    connect(m_gameView, &AppListView::clicked, m_appsManager, &AppsManager::launchApp);
-    connect(m_officeView, &AppListView::clicked, m_appsManager, &AppsManager::launchApp);
-    connect(m_readingView, &AppListView::clicked, m_appsManager, &AppsManager::launchApp);
-    connect(m_developmentView, &AppListView::clicked, m_appsManager, &AppsManager::launchApp);
-    connect(m_systemView, &AppListView::clicked, m_appsManager, &AppsManager::launchApp);
-    connect(m_othersView, &AppListView::clicked, m_appsManager, &AppsManager::launchApp);
+    connect(m_categoryView, &AppGridView::clicked, m_appsManager, &AppsManager::launchApp);
 
     connect(m_allAppsView, &AppListView::clicked, this, &MainFrame::hide);
-    connect(m_internetView, &AppListView::clicked, this, &MainFrame::hide);
-    connect(m_chatView, &AppListView::clicked, this, &MainFrame::hide);
-    connect(m_musicView, &AppListView::clicked, this, &MainFrame::hide);
-    connect(m_videoView, &AppListView::clicked, this, &MainFrame::hide);
-    connect(m_graphicsView, &AppListView::clicked, this, &MainFrame::hide);
-    connect(m_gameView, &AppListView::clicked, this, &MainFrame::hide);
-    connect(m_officeView, &AppListView::clicked, this, &MainFrame::hide);
-    connect(m_readingView, &AppListView::clicked, this, &MainFrame::hide);
-    connect(m_developmentView, &AppListView::clicked, this, &MainFrame::hide);
-    connect(m_systemView, &AppListView::clicked, this, &MainFrame::hide);
-    connect(m_othersView, &AppListView::clicked, this, &MainFrame::hide);
+    connect(m_categoryView, &AppGridView::clicked, this, &MainFrame::hide);
 
     connect(m_appItemDelegate, &AppItemDelegate::currentChanged, m_allAppsView, static_cast<void (AppListView::*)(const QModelIndex&)>(&AppListView::update));
-    connect(m_appItemDelegate, &AppItemDelegate::currentChanged, m_internetView, static_cast<void (AppListView::*)(const QModelIndex&)>(&AppListView::update));
-    connect(m_appItemDelegate, &AppItemDelegate::currentChanged, m_chatView, static_cast<void (AppListView::*)(const QModelIndex&)>(&AppListView::update));
-    connect(m_appItemDelegate, &AppItemDelegate::currentChanged, m_musicView, static_cast<void (AppListView::*)(const QModelIndex&)>(&AppListView::update));
-    connect(m_appItemDelegate, &AppItemDelegate::currentChanged, m_videoView, static_cast<void (AppListView::*)(const QModelIndex&)>(&AppListView::update));
-    connect(m_appItemDelegate, &AppItemDelegate::currentChanged, m_graphicsView, static_cast<void (AppListView::*)(const QModelIndex&)>(&AppListView::update));
-    connect(m_appItemDelegate, &AppItemDelegate::currentChanged, m_gameView, static_cast<void (AppListView::*)(const QModelIndex&)>(&AppListView::update));
-    connect(m_appItemDelegate, &AppItemDelegate::currentChanged, m_officeView, static_cast<void (AppListView::*)(const QModelIndex&)>(&AppListView::update));
-    connect(m_appItemDelegate, &AppItemDelegate::currentChanged, m_readingView, static_cast<void (AppListView::*)(const QModelIndex&)>(&AppListView::update));
-    connect(m_appItemDelegate, &AppItemDelegate::currentChanged, m_developmentView, static_cast<void (AppListView::*)(const QModelIndex&)>(&AppListView::update));
-    connect(m_appItemDelegate, &AppItemDelegate::currentChanged, m_systemView, static_cast<void (AppListView::*)(const QModelIndex&)>(&AppListView::update));
-    connect(m_appItemDelegate, &AppItemDelegate::currentChanged, m_othersView, static_cast<void (AppListView::*)(const QModelIndex&)>(&AppListView::update));
+    connect(m_appItemDelegate, &AppItemDelegate::currentChanged, m_categoryView, static_cast<void (AppGridView::*)(const QModelIndex&)>(&AppGridView::update));
 
     connect(m_appsArea, &AppListArea::mouseEntered, this, &MainFrame::refreshTitleVisible);
     connect(m_navigationWidget, &NavigationWidget::mouseEntered, this, &MainFrame::refreshTitleVisible);
@@ -759,6 +609,66 @@ void MainFrame::updateGeometry()
     QFrame::updateGeometry();
 }
 
+///
+/// \brief MainFrame::scheduleStandby prepare window again when it's hidden, something shown in it is changed
+///
+void MainFrame::scheduleStandby()
+{
+    m_standbyReady = false;
+
+    if (!isVisible())
+        m_standbyTimer->start();
+}
+
+///
+/// \brief MainFrame::prepareStandby do the work of showing while window is hidden
+///
+/// search is reset, native window is created and placed, layouts are activated
+/// and the whole window is painted once offscreen, so style, font and app icon
+/// caches are ready for the first frame. showEvent skips all of these when
+/// standby is ready, it only maps the window and updates focus.
+///
+void MainFrame::prepareStandby()
+{
+    if (isVisible())
+        return;
+
+    PERF_TRACE("MainFrame::prepareStandby");
+
+    m_searchWidget->clearSearchContent();
+    XcbMisc::instance()->set_deepin_override(winId());
+    updateGeometry();
+    layout()->activate();
+
+    // rendering a hidden widget sends pending resize events, scroll area is laid out too
+    QPixmap frame(size());
+    frame.fill(Qt::transparent);
+    render(&frame);
+
+    showGradient();
+    updateCurrentVisibleCategory();
+
+    m_standbyReady = true;
+}
+
+///
+/// \brief MainFrame::showFramePainted first frame after show is painted, record the show latency
+///
+void MainFrame::showFramePainted()
+{
+    if (!m_showTimer.isValid())
+        return;
+
+    m_lastShowLatency = m_showTimer.nsecsElapsed() / 1000;
+    m_totalShowLatency += m_lastShowLatency;
+    ++m_showCount;
+    m_showTimer.invalidate();
+
+#ifdef WITH_PERF_TRACE
+    qDebug() << "show latency:" << m_lastShowLatency << "us, average:" << averageShowLatency() << "us";
+#endif
+}
+
 void MainFrame::moveCurrentSelectApp(const int key)
 {
     const QModelIndex currentIndex = m_appItemDelegate->currentIndex();
@@ -766,7 +676,7 @@ void MainFrame::moveCurrentSelectApp(const int key)
 
     if (!currentIndex.isValid())
     {
-        m_appItemDelegate->setCurrentIndex(m_displayMode == GroupByCategory ? m_internetView->indexAt(0) : m_allAppsView->indexAt(0));
+        m_appItemDelegate->setCurrentIndex(m_displayMode == GroupByCategory ? m_categoryModel->appIndex(0, 0) : m_allAppsView->indexAt(0));
         update();
         return;
     }
@@ -774,70 +684,33 @@ void MainFrame::moveCurrentSelectApp(const int key)
     const int column = m_calcUtil->appColumnCount();
     QModelIndex index;
 
-    switch (key)
+    // category view keeps column when move across categories
+    if (currentIndex.model() == m_categoryModel)
     {
-    case Qt::Key_Backtab:
-    case Qt::Key_Left:      index = currentIndex.sibling(currentIndex.row() - 1, 0);        break;
-    case Qt::Key_Tab:
-    case Qt::Key_Right:     index = currentIndex.sibling(currentIndex.row() + 1, 0);        break;
-    case Qt::Key_Up:        index = currentIndex.sibling(currentIndex.row() - column, 0);   break;
-    case Qt::Key_Down:      index = currentIndex.sibling(currentIndex.row() + column, 0);   break;
-    default:;
+        switch (key)
+        {
+        case Qt::Key_Backtab:
+        case Qt::Key_Left:      index = m_categoryView->moveIndex(currentIndex, QAbstractItemView::MoveLeft);     break;
+        case Qt::Key_Tab:
+        case Qt::Key_Right:     index = m_categoryView->moveIndex(currentIndex, QAbstractItemView::MoveRight);    break;
+        case Qt::Key_Up:        index = m_categoryView->moveIndex(currentIndex, QAbstractItemView::MoveUp);       break;
+        case Qt::Key_Down:      index = m_categoryView->moveIndex(currentIndex, QAbstractItemView::MoveDown);     break;
+        default:;
+        }
     }
-
-    do {
-        if (index.isValid())
-            break;
-
-        const int realColumn = currentIndex.row() % column;
-        const AppsListModel *model = static_cast<const AppsListModel *>(currentIndex.model());
-        if (key == Qt::Key_Down || key == Qt::Key_Right || key == Qt::Key_Tab)
-            model = nextCategoryModel(model);
-        else
-            model = prevCategoryModel(model);
-
-        // need to keep column
-        if (key == Qt::Key_Up || key == Qt::Key_Down)
-            while (model && model->rowCount(QModelIndex()) <= realColumn)
-                if (key == Qt::Key_Down)
-                    model = nextCategoryModel(model);
-                else
-                    model = prevCategoryModel(model);
-        else
-            while (model && !model->rowCount(QModelIndex()))
-                if (key == Qt::Key_Right || key == Qt::Key_Tab)
-                    model = nextCategoryModel(model);
-                else
-                    model = prevCategoryModel(model);
-
-        if (!model)
-            break;
-
-        const int count = model->rowCount(QModelIndex()) - 1;
-        int realIndex = count;
-
+    else
+    {
         switch (key)
         {
-        case Qt::Key_Down:
-            index = model->index(realColumn);
-            break;
-        case Qt::Key_Up:
-            while (realIndex && realIndex % column != realColumn)
-                --realIndex;
-            index = model->index(realIndex);
-            break;
-        case Qt::Key_Left:
         case Qt::Key_Backtab:
-            index = model->index(count);
-            break;
-        case Qt::Key_Right:
+        case Qt::Key_Left:      index = currentIndex.sibling(currentIndex.row() - 1, 0);        break;
         case Qt::Key_Tab:
-            index = model->index(0);
-            break;
+        case Qt::Key_Right:     index = currentIndex.sibling(currentIndex.row() + 1, 0);        break;
+        case Qt::Key_Up:        index = currentIndex.sibling(currentIndex.row() - column, 0);   break;
+        case Qt::Key_Down:      index = currentIndex.sibling(currentIndex.row() + column, 0);   break;
         default:;
         }
-
-    } while (false);
+    }
 
     const QModelIndex selectedIndex = index.isValid() ? index : currentIndex;
     m_appItemDelegate->setCurrentIndex(selectedIndex);
@@ -869,7 +742,7 @@ void MainFrame::launchCurrentApp()
     {
     case Search:
     case AllApps:           m_appsManager->launchApp(m_allAppsView->indexAt(0));     break;
-    case GroupByCategory:   m_appsManager->launchApp(m_internetView->indexAt(0));    break;
+    case GroupByCategory:   m_appsManager->launchApp(m_categoryModel->appIndex(0, 0));   break;
     }
 
     hide();
@@ -944,43 +817,28 @@ void MainFrame::ensureScrollToDest(const QVariant &value)
         return;
 
     QPropertyAnimation *ani = qobject_cast<QPropertyAnimation *>(sender());
+    const int dest = categoryScrollOffset(m_scrollDest);
 
-    if (m_scrollDest->y() != ani->endValue())
-        ani->setEndValue(m_scrollDest->y());
+    if (dest != -1 && dest != ani->endValue())
+        ani->setEndValue(dest);
 }
 
 void MainFrame::ensureItemVisible(const QModelIndex &index)
 {
-    AppListView *view = nullptr;
-    const AppsListModel::AppCategory category = index.data(AppsListModel::AppCategoryRole).value<AppsListModel::AppCategory>();
+    int y = 0;
 
     if (m_displayMode == Search || m_displayMode == AllApps)
-        view = m_allAppsView;
+        y = m_allAppsView->indexYOffset(index) + m_allAppsView->pos().y();
+    else if (index.model() == m_categoryModel)
+        y = m_categoryView->indexYOffset(index) + m_categoryView->pos().y();
     else
-        view = categoryView(category);
-
-    if (!view)
         return;
 
-    m_appsArea->ensureVisible(0, view->indexYOffset(index) + view->pos().y(), 0, DLauncher::APPS_AREA_ENSURE_VISIBLE_MARGIN_Y);
+    m_appsArea->ensureVisible(0, y, 0, DLauncher::APPS_AREA_ENSURE_VISIBLE_MARGIN_Y);
     updateCurrentVisibleCategory();
     refershCurrentFloatTitle();
 }
 
-void MainFrame::refershCategoryVisible(const AppsListModel::AppCategory category, const int appNums)
-{
-    if (m_displayMode != GroupByCategory)
-        return;
-
-    QWidget *categoryTitle = this->categoryTitle(category);
-    QWidget *categoryView = this->categoryView(category);
-
-    if (categoryView)
-        categoryView->setVisible(appNums);
-    if (categoryTitle)
-        categoryTitle->setVisible(appNums);
-}
-
 void MainFrame::updateDisplayMode(const DisplayMode mode)
 {
     if (m_displayMode == mode)
@@ -991,28 +849,7 @@ void MainFrame::updateDisplayMode(const DisplayMode mode)
     bool isCategoryMode = m_displayMode == GroupByCategory;
 
     m_allAppsView->setVisible(!isCategoryMode);
-    m_internetTitle->setVisible(isCategoryMode);
-    m_internetView->setVisible(isCategoryMode);
-    m_chatTitle->setVisible(isCategoryMode);
-    m_chatView->setVisible(isCategoryMode);
-    m_musicTitle->setVisible(isCategoryMode);
-    m_musicView->setVisible(isCategoryMode);
-    m_videoTitle->setVisible(isCategoryMode);
-    m_videoView->setVisible(isCategoryMode);
-    m_graphicsTitle->setVisible(isCategoryMode);
-    m_graphicsView->setVisible(isCategoryMode);
-    m_gameTitle->setVisible(isCategoryMode);
-    m_gameView->setVisible(isCategoryMode);
-    m_officeTitle->setVisible(isCategoryMode);
-    m_officeView->setVisible(isCategoryMode);
-    m_readingTitle->setVisible(isCategoryMode);
-    m_readingView->setVisible(isCategoryMode);
-    m_developmentTitle->setVisible(isCategoryMode);
-    m_developmentView->setVisible(isCategoryMode);
-    m_systemTitle->setVisible(isCategoryMode);
-    m_systemView->setVisible(isCategoryMode);
-    m_othersTitle->setVisible(isCategoryMode);
-    m_othersView->setVisible(isCategoryMode);
+    m_categoryView->setVisible(isCategoryMode);
 
     m_viewListPlaceholder->setVisible(isCategoryMode);
     m_navigationWidget->setButtonsVisible(isCategoryMode);
@@ -1048,32 +885,11 @@ void MainFrame::updateCurrentVisibleCategory()
     if (m_displayMode != GroupByCategory)
         return;
 
-    AppsListModel::AppCategory currentVisibleCategory;
-
-    if (!m_internetView->visibleRegion().isEmpty())
-        currentVisibleCategory = AppsListModel::Internet;
-    else if (!m_chatView->visibleRegion().isEmpty())
-        currentVisibleCategory = AppsListModel::Chat;
-    else if (!m_musicView->visibleRegion().isEmpty())
-        currentVisibleCategory = AppsListModel::Music;
-    else if (!m_videoView->visibleRegion().isEmpty())
-        currentVisibleCategory = AppsListModel::Video;
-    else if (!m_graphicsView->visibleRegion().isEmpty())
-        currentVisibleCategory = AppsListModel::Graphics;
-    else if (!m_gameView->visibleRegion().isEmpty())
-        currentVisibleCategory = AppsListModel::Game;
-    else if (!m_officeView->visibleRegion().isEmpty())
-        currentVisibleCategory = AppsListModel::Office;
-    else if (!m_readingView->visibleRegion().isEmpty())
-        currentVisibleCategory = AppsListModel::Reading;
-    else if (!m_developmentView->visibleRegion().isEmpty())
-        currentVisibleCategory = AppsListModel::Development;
-    else if (!m_systemView->visibleRegion().isEmpty())
-        currentVisibleCategory = AppsListModel::System;
-    else if (!m_othersView->visibleRegion().isEmpty())
-        currentVisibleCategory = AppsListModel::Others;
-    else
-        Q_ASSERT(false);
+    // first category has apps shown in scroll area viewport
+    const int y = m_appsArea->verticalScrollBar()->value() - m_categoryView->y();
+    const AppsListModel::AppCategory currentVisibleCategory = m_categoryView->categoryAt(y);
+    if (currentVisibleCategory == AppsListModel::All)
+        return;
 
     if (m_currentCategory == currentVisibleCategory)
         return;
@@ -1085,10 +901,14 @@ void MainFrame::updateCurrentVisibleCategory()
 
 void MainFrame::updatePlaceholderSize()
 {
-    const AppListView *view = lastVisibleView();
-    Q_ASSERT(view);
+    const int sections = m_categoryModel->sectionCount();
+    if (!sections)
+        return;
+
+    // let the last category can be scrolled to top
+    const QRect lastCategory = m_categoryView->categoryRect(m_categoryModel->sectionCategory(sections - 1));
 
-    m_viewListPlaceholder->setFixedHeight(m_appsArea->height() - view->height() - DLauncher::APPS_AREA_BOTTOM_MARGIN);
+    m_viewListPlaceholder->setFixedHeight(m_appsArea->height() - lastCategory.height() - DLauncher::APPS_AREA_BOTTOM_MARGIN);
 }
 
 void MainFrame::updateDockPosition()
@@ -1108,90 +928,24 @@ MainFrame::DisplayMode MainFrame::getDisplayMode()
     return AllApps;
 }
 
-AppsListModel *MainFrame::nextCategoryModel(const AppsListModel *currentModel)
-{
-    if (currentModel == nullptr)
-        return m_internetModel;
-    if (currentModel == m_internetModel)
-        return m_chatModel;
-    if (currentModel == m_chatModel)
-        return m_musicModel;
-    if (currentModel == m_musicModel)
-        return m_videoModel;
-    if (currentModel == m_videoModel)
-        return m_graphicsModel;
-    if (currentModel == m_graphicsModel)
-        return m_gameModel;
-    if (currentModel == m_gameModel)
-        return m_officeModel;
-    if (currentModel == m_officeModel)
-        return m_readingModel;
-    if (currentModel == m_readingModel)
-        return m_developmentModel;
-    if (currentModel == m_developmentModel)
-        return m_systemModel;
-    if (currentModel == m_systemModel)
-        return m_othersModel;
-    if (currentModel == m_othersModel)
-        return nullptr;
-
-    return nullptr;
-}
-
-AppsListModel *MainFrame::prevCategoryModel(const AppsListModel *currentModel)
-{
-    if (currentModel == m_internetModel)
-        return nullptr;
-    if (currentModel == m_chatModel)
-        return m_internetModel;
-    if (currentModel == m_musicModel)
-        return m_chatModel;
-    if (currentModel == m_videoModel)
-        return m_musicModel;
-    if (currentModel == m_graphicsModel)
-        return m_videoModel;
-    if (currentModel == m_gameModel)
-        return m_graphicsModel;
-    if (currentModel == m_officeModel)
-        return m_gameModel;
-    if (currentModel == m_readingModel)
-        return m_officeModel;
-    if (currentModel == m_developmentModel)
-        return m_readingModel;
-    if (currentModel == m_systemModel)
-        return m_developmentModel;
-    if (currentModel == m_othersModel)
-        return m_systemModel;
-
-    return nullptr;
-}
-
 void MainFrame::layoutChanged()
 {
     const int appsContentWidth = m_appsArea->width();
 
     m_appsVbox->setFixedWidth(appsContentWidth);
     m_allAppsView->setFixedWidth(appsContentWidth);
-    m_internetView->setFixedWidth(appsContentWidth);
-    m_musicView->setFixedWidth(appsContentWidth);
-    m_videoView->setFixedWidth(appsContentWidth);
-    m_graphicsView->setFixedWidth(appsContentWidth);
-    m_gameView->setFixedWidth(appsContentWidth);
-    m_officeView->setFixedWidth(appsContentWidth);
-    m_readingView->setFixedWidth(appsContentWidth);
-    m_developmentView->setFixedWidth(appsContentWidth);
-    m_systemView->setFixedWidth(appsContentWidth);
-    m_othersView->setFixedWidth(appsContentWidth);
+    m_categoryView->setFixedWidth(appsContentWidth);
 
     m_floatTitle->move(m_appsArea->pos().x(), m_appsArea->y() - m_floatTitle->height() + 20);
 }
 
 void MainFrame::searchTextChanged(const QString &keywords)
 {
-    m_appsManager->searchApp(keywords);
-
     if (keywords.isEmpty())
         updateDisplayMode(getDisplayMode());
     else
         updateDisplayMode(Search);
+
+    // search result is ready synchronously, switch to search mode first to show tips.
+    m_appsManager->searchApp(keywords);
 }
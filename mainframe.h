@@ -11,7 +11,9 @@
 #include "global_util/constants.h"
 #include "model/appsmanager.h"
 #include "model/appslistmodel.h"
+#include "model/groupedappsmodel.h"
 #include "view/applistview.h"
+#include "view/appgridview.h"
 #include "worker/menuworker.h"
 #include "dbusinterface/dbusdisplay.h"
 #include "widgets/applistarea.h"
@@ -23,6 +25,7 @@
 #include <QSettings>
 #include <QTimer>
 #include <QGSettings>
+#include <QElapsedTimer>
 
 #include <dboxwidget.h>
 
@@ -50,6 +53,12 @@ public:
     void showByMode(const qlonglong mode);
     int dockPosition();
 
+    void startShowTiming();
+    // time from Show request to first frame of window, in microseconds
+    inline qint64 lastShowLatency() const {return m_lastShowLatency;}
+    inline qint64 averageShowLatency() const {return m_showCount ? m_totalShowLatency / m_showCount : -1;}
+    inline int showCount() const {return m_showCount;}
+
 signals:
     void categoryAppNumsChanged(const AppsListModel::AppCategory category, const int appNums);
     void displayModeChanged(const DisplayMode mode);
@@ -64,6 +73,7 @@ protected:
     void resizeEvent(QResizeEvent *e);
     void keyPressEvent(QKeyEvent *e);
     void showEvent(QShowEvent *e);
+    void hideEvent(QHideEvent *e);
     void mouseReleaseEvent(QMouseEvent *e);
     void wheelEvent(QWheelEvent *e);
     void paintEvent(QPaintEvent *e);
@@ -84,26 +94,23 @@ private:
     void updateCurrentVisibleCategory();
     void updatePlaceholderSize();
     void updateDockPosition();
+    void scheduleStandby();
+    void prepareStandby();
+    void showFramePainted();
     DisplayMode getDisplayMode();
 
-    AppsListModel *nextCategoryModel(const AppsListModel *currentModel);
-    AppsListModel *prevCategoryModel(const AppsListModel *currentModel);
-
 private slots:
     void layoutChanged();
     void searchTextChanged(const QString &keywords);
     void ensureScrollToDest(const QVariant &value);
     void ensureItemVisible(const QModelIndex &index);
-    void refershCategoryVisible(const AppsListModel::AppCategory category, const int appNums);
     void showGradient();
     void refreshTitleVisible();
     void refershCategoryTextVisible();
     void refershCurrentFloatTitle();
 
 private:
-    CategoryTitleWidget *categoryTitle(const AppsListModel::AppCategory category) const;
-    AppListView *categoryView(const AppsListModel::AppCategory category) const;
-    AppListView *lastVisibleView() const;
+    int categoryScrollOffset(const AppsListModel::AppCategory category) const;
 
 private:
     bool m_isConfirmDialogShown = false;
@@ -120,9 +127,17 @@ private:
     CalculateUtil *m_calcUtil;
     AppsManager *m_appsManager;
     QPropertyAnimation *m_scrollAnimation;
-    QWidget *m_scrollDest;
+    AppsListModel::AppCategory m_scrollDest = AppsListModel::All;
     QTimer *m_delayHideTimer;
     QTimer *m_autoScrollTimer;
+    QTimer *m_standbyTimer;
+    // window is laid out and painted while hidden, show only need to map it
+    bool m_standbyReady = false;
+
+    QElapsedTimer m_showTimer;
+    qint64 m_lastShowLatency = -1;
+    qint64 m_totalShowLatency = 0;
+    int m_showCount = 0;
 
     NavigationWidget *m_navigationWidget;
     QWidget *m_rightSpacing;
@@ -137,45 +152,18 @@ private:
     AppItemDelegate *m_appItemDelegate;
     GradientLabel* m_topGradient;
     GradientLabel* m_bottomGradient;
+    // background and rects of gradient pixmaps, skip copy when nothing is changed
+    qint64 m_gradientBackgroundKey = 0;
+    QRect m_topGradientRect;
+    QRect m_bottomGradientRect;
 
     AppListView *m_allAppsView;
-    AppListView *m_internetView;
-    AppListView * m_chatView;
-    AppListView *m_musicView;
-    AppListView *m_videoView;
-    AppListView *m_graphicsView;
-    AppListView *m_gameView;
-    AppListView *m_officeView;
-    AppListView *m_readingView;
-    AppListView *m_developmentView;
-    AppListView *m_systemView;
-    AppListView *m_othersView;
+    AppGridView *m_categoryView;
     AppsListModel *m_allAppsModel;
     AppsListModel *m_searchResultModel;
-    AppsListModel *m_internetModel;
-    AppsListModel *m_chatModel;
-    AppsListModel *m_musicModel;
-    AppsListModel *m_videoModel;
-    AppsListModel *m_graphicsModel;
-    AppsListModel *m_gameModel;
-    AppsListModel *m_officeModel;
-    AppsListModel *m_readingModel;
-    AppsListModel *m_developmentModel;
-    AppsListModel *m_systemModel;
-    AppsListModel *m_othersModel;
+    GroupedAppsModel *m_categoryModel;
 
     CategoryTitleWidget* m_floatTitle;
-    CategoryTitleWidget *m_internetTitle;
-    CategoryTitleWidget *m_chatTitle;
-    CategoryTitleWidget *m_musicTitle;
-    CategoryTitleWidget *m_videoTitle;
-    CategoryTitleWidget *m_graphicsTitle;
-    CategoryTitleWidget *m_gameTitle;
-    CategoryTitleWidget *m_officeTitle;
-    CategoryTitleWidget *m_readingTitle;
-    CategoryTitleWidget *m_developmentTitle;
-    CategoryTitleWidget *m_systemTitle;
-    CategoryTitleWidget *m_othersTitle;
 
     QVBoxLayout *m_scrollAreaLayout;
     QHBoxLayout *m_mainLayout;
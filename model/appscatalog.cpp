@@ -0,0 +1,152 @@
+#include "appscatalog.h"
+
+const AppsCatalog::AppId AppsCatalog::InvalidId;
+
+///
+/// \brief AppsCatalog::insert add app to catalog, or replace the app which has the same key
+/// \param info app item info
+/// \return id of the app
+///
+AppsCatalog::AppId AppsCatalog::insert(const ItemInfo &info)
+{
+    const auto it = m_ids.constFind(info.m_key);
+    if (it != m_ids.constEnd())
+    {
+        if (m_items[it.value()].m_name != info.m_name)
+            m_nameKeys.remove(it.value());
+
+        m_items[it.value()] = info;
+        return it.value();
+    }
+
+    AppId id;
+    if (m_freeIds.isEmpty())
+    {
+        id = m_items.size();
+        m_items.append(info);
+    } else {
+        id = m_freeIds.takeLast();
+        m_items[id] = info;
+    }
+
+    m_ids.insert(info.m_key, id);
+
+    return id;
+}
+
+///
+/// \brief AppsCatalog::remove remove app from catalog, its id will be reused
+/// \param appKey app key
+/// \return false if app is not in catalog
+///
+bool AppsCatalog::remove(const QString &appKey)
+{
+    const auto it = m_ids.find(appKey);
+    if (it == m_ids.end())
+        return false;
+
+    const AppId id = it.value();
+    m_ids.erase(it);
+    m_items[id] = ItemInfo();
+    m_nameKeys.remove(id);
+    m_freeIds.append(id);
+
+    return true;
+}
+
+///
+/// \brief AppsCatalog::reset replace all apps, apps still exist keep their ids
+/// \param infoList new apps list
+///
+void AppsCatalog::reset(const ItemInfoList &infoList)
+{
+    QHash<QString, AppId> oldIds;
+    oldIds.swap(m_ids);
+    m_ids.reserve(infoList.size());
+
+    for (const ItemInfo &info : infoList)
+    {
+        const auto it = oldIds.find(info.m_key);
+        if (it == oldIds.end())
+            continue;
+
+        if (m_items[it.value()].m_name != info.m_name)
+            m_nameKeys.remove(it.value());
+
+        m_items[it.value()] = info;
+        m_ids.insert(info.m_key, it.value());
+        oldIds.erase(it);
+    }
+
+    // release ids of removed apps before allocating new ids
+    for (const AppId id : oldIds)
+    {
+        m_items[id] = ItemInfo();
+        m_nameKeys.remove(id);
+        m_freeIds.append(id);
+    }
+
+    for (const ItemInfo &info : infoList)
+        if (!m_ids.contains(info.m_key))
+            insert(info);
+}
+
+void AppsCatalog::clear()
+{
+    m_items.clear();
+    m_freeIds.clear();
+    m_ids.clear();
+    m_nameKeys.clear();
+}
+
+const ItemInfo *AppsCatalog::find(const QString &appKey) const
+{
+    const auto it = m_ids.constFind(appKey);
+    if (it == m_ids.constEnd())
+        return nullptr;
+
+    return &m_items[it.value()];
+}
+
+///
+/// \brief AppsCatalog::items list all apps in id order
+///
+const ItemInfoList AppsCatalog::items() const
+{
+    ItemInfoList list;
+    list.reserve(m_ids.size());
+
+    for (const ItemInfo &info : m_items)
+        if (!info.m_key.isEmpty())
+            list.append(info);
+
+    return list;
+}
+
+///
+/// \brief AppsCatalog::setCollationLocale set locale of name collation keys, cached keys are dropped if it's changed
+///
+void AppsCatalog::setCollationLocale(const QLocale &locale)
+{
+    if (m_collator.locale() == locale)
+        return;
+
+    m_collator.setLocale(locale);
+    m_nameKeys.clear();
+}
+
+///
+/// \brief AppsCatalog::nameSortKey collation key of app name, cached if app is in catalog with the same name
+///
+const QCollatorSortKey AppsCatalog::nameSortKey(const ItemInfo &info) const
+{
+    const AppId appId = id(info.m_key);
+    if (appId == InvalidId || m_items[appId].m_name != info.m_name)
+        return m_collator.sortKey(info.m_name);
+
+    const auto it = m_nameKeys.constFind(appId);
+    if (it != m_nameKeys.constEnd())
+        return it.value();
+
+    return m_nameKeys.insert(appId, m_collator.sortKey(info.m_name)).value();
+}
@@ -0,0 +1,51 @@
+#ifndef APPSCATALOG_H
+#define APPSCATALOG_H
+
+#include "dbusinterface/dbusvariant/iteminfo.h"
+
+#include <QHash>
+#include <QVector>
+#include <QCollator>
+
+///
+/// \brief The AppsCatalog class holds all installed apps, indexed by app key
+///
+/// every app gets an integer id which is stable while the app is in catalog,
+/// ids of removed apps are reused by apps inserted later.
+///
+/// collation keys of app names are computed on first use and kept until the
+/// name or the collation locale is changed.
+///
+class AppsCatalog
+{
+public:
+    typedef int AppId;
+    static const AppId InvalidId = -1;
+
+    AppId insert(const ItemInfo &info);
+    bool remove(const QString &appKey);
+    void reset(const ItemInfoList &infoList);
+    void clear();
+
+    inline int size() const {return m_ids.size();}
+    inline bool isEmpty() const {return m_ids.isEmpty();}
+    inline bool contains(const QString &appKey) const {return m_ids.contains(appKey);}
+    inline AppId id(const QString &appKey) const {return m_ids.value(appKey, InvalidId);}
+    inline const ItemInfo &item(const AppId id) const {return m_items[id];}
+    const ItemInfo *find(const QString &appKey) const;
+    const ItemInfoList items() const;
+
+    void setCollationLocale(const QLocale &locale);
+    const QCollatorSortKey nameSortKey(const ItemInfo &info) const;
+
+private:
+    QCollator m_collator;
+    // app id -> collation key of app name
+    mutable QHash<AppId, QCollatorSortKey> m_nameKeys;
+
+    QVector<ItemInfo> m_items;
+    QVector<AppId> m_freeIds;
+    QHash<QString, AppId> m_ids;
+};
+
+#endif // APPSCATALOG_H
@@ -2,6 +2,7 @@
 #include "appsmanager.h"
 #include "global_util/calculate_util.h"
 #include "global_util/constants.h"
+#include "global_util/perftrace.h"
 #include "dbusinterface/dbusvariant/iteminfo.h"
 
 #include <QSize>
@@ -18,6 +19,14 @@ AppsListModel::AppsListModel(const AppCategory &category, QObject *parent) :
 {
     connect(m_appsManager, &AppsManager::dataChanged, this, &AppsListModel::dataChanged);
     connect(m_appsManager, &AppsManager::layoutChanged, this, &AppsListModel::layoutChanged);
+    connect(m_appsManager, &AppsManager::iconChanged, this, &AppsListModel::iconChanged);
+    connect(m_appsManager, &AppsManager::itemAboutToBeInserted, this, &AppsListModel::itemAboutToBeInserted);
+    connect(m_appsManager, &AppsManager::itemInserted, this, &AppsListModel::itemInserted);
+    connect(m_appsManager, &AppsManager::itemAboutToBeRemoved, this, &AppsListModel::itemAboutToBeRemoved);
+    connect(m_appsManager, &AppsManager::itemRemoved, this, &AppsListModel::itemRemoved);
+    connect(m_appsManager, &AppsManager::itemDataChanged, this, &AppsListModel::itemDataChanged);
+    // icon size is changed
+    connect(m_calcUtil, &CalculateUtil::layoutChanged, this, [this] {m_roleCache.clear();});
 }
 
 ///
@@ -53,6 +62,7 @@ void AppsListModel::dropInsert(const QString &appKey, const int pos)
 {
     beginInsertRows(QModelIndex(), pos, pos);
     m_appsManager->restoreItem(appKey, pos);
+    m_roleCache.clear();
     endInsertRows();
 }
 
@@ -99,16 +109,10 @@ const QModelIndex AppsListModel::indexAt(const QString &appKey) const
 {
     Q_ASSERT(m_category == All);
 
-    int i = 0;
-    const int count = rowCount(QModelIndex());
-    while (i != count)
-    {
-        if (index(i).data(AppKeyRole).toString() == appKey)
-            return index(i);
-        ++i;
-    }
+    const int row = m_appsManager->appRow(appKey);
+    Q_ASSERT(row != -1);
 
-    Q_UNREACHABLE();
+    return index(row);
 }
 
 bool AppsListModel::removeRows(int row, int count, const QModelIndex &parent)
@@ -122,6 +126,7 @@ bool AppsListModel::removeRows(int row, int count, const QModelIndex &parent)
 
     beginRemoveRows(parent, row, row);
     m_appsManager->stashItem(index(row));
+    m_roleCache.clear();
     endRemoveRows();
 
     return true;
@@ -161,11 +166,37 @@ QMimeData *AppsListModel::mimeData(const QModelIndexList &indexes) const
 
 QVariant AppsListModel::data(const QModelIndex &index, int role) const
 {
-    if (!index.isValid() || index.row() >= m_appsManager->appsInfoList(m_category).size())
+    PERF_TRACE("AppsListModel::data");
+
+    const ItemInfoList &list = m_appsManager->appsInfoList(m_category);
+    if (!index.isValid() || index.row() >= list.size())
         return QVariant();
 
-    const ItemInfo itemInfo = m_appsManager->appsInfoList(m_category)[index.row()];
+    const ItemInfo &itemInfo = list[index.row()];
+
+    // roles need lookup in appsManager are cached until row is changed
+    const bool cacheable = role == AppIconRole || role == AppAutoStartRole ||
+                           role == AppNewInstallRole || role == AppIsRemovableRole;
+    if (cacheable)
+    {
+        if (m_roleCache.size() != list.size())
+            m_roleCache.resize(list.size());
+
+        const QHash<int, QVariant> &rowCache = m_roleCache[index.row()];
+        const auto cached = rowCache.constFind(role);
+        if (cached != rowCache.constEnd())
+            return cached.value();
+    }
+
+    const QVariant value = roleData(itemInfo, index, role);
+    if (cacheable)
+        m_roleCache[index.row()].insert(role, value);
+
+    return value;
+}
 
+QVariant AppsListModel::roleData(const ItemInfo &itemInfo, const QModelIndex &index, int role) const
+{
     switch (role)
     {
     case AppRawItemInfoRole:
@@ -185,7 +216,7 @@ QVariant AppsListModel::data(const QModelIndex &index, int role) const
     case AppAutoStartRole:
         return m_appsManager->appIsAutoStart(itemInfo.m_desktop);
     case AppIsOnDesktopRole:
-        return m_appsManager->appIsOnDesktop(itemInfo.m_key);
+        return m_appsManager->appIsOnDesktop(itemInfo.m_desktop);
     case AppIsOnDockRole:
         return m_appsManager->appIsOnDock(itemInfo.m_desktop);
     case AppIsRemovableRole:
@@ -228,7 +259,10 @@ Qt::ItemFlags AppsListModel::flags(const QModelIndex &index) const
 void AppsListModel::dataChanged(const AppCategory category)
 {
     if (category == All || category == m_category)
+    {
+        m_roleCache.clear();
         emit QAbstractItemModel::dataChanged(index(0), index(rowCount(QModelIndex())));
+    }
 }
 
 ///
@@ -238,7 +272,72 @@ void AppsListModel::dataChanged(const AppCategory category)
 void AppsListModel::layoutChanged(const AppsListModel::AppCategory category)
 {
     if (category == All || category == m_category)
+    {
+        m_roleCache.clear();
         emit QAbstractItemModel::layoutChanged();
+    }
+}
+
+///
+/// \brief AppsListModel::iconChanged tell view the icon is loaded, only rows using this icon will be updated
+/// \param iconKey icon key of app item
+///
+void AppsListModel::iconChanged(const QString &iconKey)
+{
+    const ItemInfoList &list = m_appsManager->appsInfoList(m_category);
+    for (int i(0); i != list.size(); ++i)
+    {
+        if (list[i].m_iconKey != iconKey)
+            continue;
+
+        if (i < m_roleCache.size())
+            m_roleCache[i].remove(AppIconRole);
+
+        const QModelIndex idx = index(i);
+        emit QAbstractItemModel::dataChanged(idx, idx, QVector<int>() << AppIconRole);
+    }
+}
+
+void AppsListModel::itemAboutToBeInserted(const AppsListModel::AppCategory category, const int row)
+{
+    if (category == m_category)
+        beginInsertRows(QModelIndex(), row, row);
+}
+
+void AppsListModel::itemInserted(const AppsListModel::AppCategory category)
+{
+    if (category != m_category)
+        return;
+
+    m_roleCache.clear();
+    endInsertRows();
+}
+
+void AppsListModel::itemAboutToBeRemoved(const AppsListModel::AppCategory category, const int row)
+{
+    if (category == m_category)
+        beginRemoveRows(QModelIndex(), row, row);
+}
+
+void AppsListModel::itemRemoved(const AppsListModel::AppCategory category)
+{
+    if (category != m_category)
+        return;
+
+    m_roleCache.clear();
+    endRemoveRows();
+}
+
+void AppsListModel::itemDataChanged(const AppsListModel::AppCategory category, const int row)
+{
+    if (category != m_category)
+        return;
+
+    if (row < m_roleCache.size())
+        m_roleCache[row].clear();
+
+    const QModelIndex idx = index(row);
+    emit QAbstractItemModel::dataChanged(idx, idx);
 }
 
 bool AppsListModel::indexDraging(const QModelIndex &index) const
@@ -2,13 +2,18 @@
 #define APPSLISTMODEL_H
 
 #include <QAbstractListModel>
+#include <QHash>
+#include <QVector>
 
+class ItemInfo;
 class AppsManager;
 class CalculateUtil;
 class AppsListModel : public QAbstractListModel
 {
     Q_OBJECT
 
+    friend class LauncherBenchmark;
+
 public:
     enum AppItemRole {
         ItemSizeHintRole = Qt::SizeHintRole,
@@ -77,6 +82,13 @@ protected:
 private:
     void dataChanged(const AppsListModel::AppCategory category);
     void layoutChanged(const AppsListModel::AppCategory category);
+    void iconChanged(const QString &iconKey);
+    void itemAboutToBeInserted(const AppsListModel::AppCategory category, const int row);
+    void itemInserted(const AppsListModel::AppCategory category);
+    void itemAboutToBeRemoved(const AppsListModel::AppCategory category, const int row);
+    void itemRemoved(const AppsListModel::AppCategory category);
+    void itemDataChanged(const AppsListModel::AppCategory category, const int row);
+    QVariant roleData(const ItemInfo &itemInfo, const QModelIndex &index, int role) const;
     bool indexDraging(const QModelIndex &index) const;
     bool itemIsRemovable(const QString &desktop) const;
 
@@ -87,6 +99,9 @@ private:
     QModelIndex m_dragStartIndex = QModelIndex();
     QModelIndex m_dragDropIndex = QModelIndex();
     AppCategory m_category = All;
+
+    // row -> (role -> data), for roles need lookup in appsManager
+    mutable QVector<QHash<int, QVariant>> m_roleCache;
 };
 
 Q_DECLARE_METATYPE(AppsListModel::AppCategory)
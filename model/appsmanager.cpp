@@ -1,6 +1,8 @@
 #include "appsmanager.h"
 #include "global_util/constants.h"
 #include "global_util/calculate_util.h"
+#include "global_util/perftrace.h"
+#include "global_util/persiststore.h"
 
 #include <QDebug>
 #include <QX11Info>
@@ -8,6 +10,41 @@
 #include <QPainter>
 #include <QDataStream>
 #include <QIODevice>
+#include <QStandardPaths>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <QDir>
+#include <QFileInfo>
+#include <QCollator>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+///
+/// \brief desktopFileName get file name of desktop file, dock abbreviates some directories, such as "/S@foo.desktop"
+///
+static inline const QString desktopFileName(const QString &desktop)
+{
+    const QString fileName = desktop.mid(desktop.lastIndexOf('/') + 1);
+    if (fileName.size() > 2 && fileName[1] == '@' && fileName[0].isUpper())
+        return fileName.mid(2);
+
+    return fileName;
+}
+
+static const quint32 SnapshotMagic = 0x534c4444; // "DDLS"
+static const quint32 SnapshotFormatVersion = 1;
+
+static inline const QString snapshotFileName()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/startup-snapshot";
+}
+
+static inline const QString userSortedOrderFileName()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericConfigLocation) + "/deepin/dde-launcher-app-order";
+}
 
 AppsManager *AppsManager::INSTANCE = nullptr;
 
@@ -19,9 +56,6 @@ QSettings AppsManager::APP_PRESET_SORTED_LIST(
 #endif
     QSettings::IniFormat);
 
-QSettings AppsManager::APP_ICON_CACHE("deepin", "dde-launcher-app-icon", nullptr);
-QSettings AppsManager::APP_AUTOSTART_CACHE("deepin", "dde-launcher-app-autostart", nullptr);
-QSettings AppsManager::APP_USER_SORTED_LIST("deepin", "dde-launcher-app-sorted-list", nullptr);
 
 AppsManager::AppsManager(QObject *parent) :
     QObject(parent),
@@ -30,25 +64,63 @@ AppsManager::AppsManager(QObject *parent) :
     m_dockedAppInter(new DBusDock(this)),
     m_themeAppIcon(new ThemeAppIcon(this)),
     m_calUtil(CalculateUtil::instance(this)),
-    m_searchTimer(new QTimer(this))
+    m_persistStore(PersistStore::instance(this)),
+    m_searchTimer(new QTimer(this)),
+    m_iconAtlasSaveTimer(new QTimer(this)),
+    m_iconRequestTimer(new QTimer(this)),
+    m_snapshotSaveTimer(new QTimer(this)),
+    m_itemChangedTimer(new QTimer(this)),
+    m_presetWatcher(new QFileSystemWatcher(this)),
+    m_desktopWatcher(new QFileSystemWatcher(this)),
+    m_autoStartWatcher(new QFileSystemWatcher(this)),
+    m_autoStartTimer(new QTimer(this)),
+    m_catalogPublishTimer(new QTimer(this)),
+    m_iconAtlas(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/icon-atlas", qApp->applicationVersion())
 {
     m_themeAppIcon->gtkInit();
-    m_newInstalledAppsList = m_launcherInter->GetAllNewInstalledApps().value();
-//    m_dockedAppsList = m_dockedAppInter->dockedApps();
+    m_presetWatcher->addPath(APP_PRESET_SORTED_LIST.fileName());
+    dockedAppsChanged();
 
-    refreshCategoryInfoList();
+    m_snapshotSaveTimer->setSingleShot(true);
+    m_snapshotSaveTimer->setInterval(2000);
+    m_itemChangedTimer->setSingleShot(true);
+    m_itemChangedTimer->setInterval(200);
 
-    if (APP_ICON_CACHE.value("version").toString() != qApp->applicationVersion())
-        refreshAppIconCache();
+    // show the last known apps immediately, and sync with daemon in background.
+    if (loadStartupSnapshot())
+    {
+        loadUserSortedList();
+        generateCategoryMap();
+        reconcileStartupSnapshot();
+    } else {
+        m_newInstalledAppsList = m_launcherInter->GetAllNewInstalledApps().value();
+        refreshCategoryInfoList();
+        saveStartupSnapshot();
+    }
 
-    if (APP_AUTOSTART_CACHE.value("version").toString() != qApp->applicationVersion())
-        refreshAppAutoStartCache();
+    refreshAppAutoStartCache();
 
     m_searchTimer->setSingleShot(true);
     m_searchTimer->setInterval(150);
-
-    connect(m_startManagerInter, &DBusStartManager::AutostartChanged, this, &AppsManager::refreshAppAutoStartCache);
+    m_iconAtlasSaveTimer->setSingleShot(true);
+    m_iconAtlasSaveTimer->setInterval(2000);
+    m_iconRequestTimer->setSingleShot(true);
+    m_iconRequestTimer->setInterval(0);
+    m_autoStartTimer->setSingleShot(true);
+    m_autoStartTimer->setInterval(100);
+    m_catalogPublishTimer->setSingleShot(true);
+    m_catalogPublishTimer->setInterval(200);
+
+    // autostart files may be written several times in one change
+    connect(m_startManagerInter, &DBusStartManager::AutostartChanged, m_autoStartTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(m_autoStartWatcher, &QFileSystemWatcher::directoryChanged, m_autoStartTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(m_autoStartWatcher, &QFileSystemWatcher::fileChanged, m_autoStartTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(m_autoStartTimer, &QTimer::timeout, this, &AppsManager::refreshAppAutoStartCache);
+#ifdef WITH_DAEMON_SEARCH
     connect(m_launcherInter, &DBusLauncher::SearchDone, this, &AppsManager::searchDone);
+#else
+    connect(m_launcherInter, &DBusLauncher::SearchDone, this, &AppsManager::mergeDaemonSearchResult);
+#endif
     connect(m_launcherInter, &DBusLauncher::UninstallSuccess, this, &AppsManager::abandonStashedItem);
     connect(m_launcherInter, &DBusLauncher::UninstallFailed, [this] (const QString &appKey) {restoreItem(appKey); emit dataChanged(AppsListModel::All);});
 //    connect(m_launcherInter, &DBusLauncher::UninstallFailed, this, &AppsManager::reStoreItem);
@@ -57,54 +129,151 @@ AppsManager::AppsManager(QObject *parent) :
     //newAppLaunched is the old one.
     connect(m_launcherInter, &DBusLauncher::NewAppLaunched, this, &AppsManager::markLaunched);
 
-//    connect(m_dockedAppInter, &DBusDock::DockedAppsChanged, this, &AppsManager::dockedAppsChanged);
+    connect(m_dockedAppInter, &DBusDock::DockedAppsChanged, this, &AppsManager::dockedAppsChanged);
     connect(m_dockedAppInter, &DBusDock::PositionChanged, this, &AppsManager::dockPositionChanged);
 
 //    connect(this, &AppsManager::handleUninstallApp, this, &AppsManager::unInstallApp);
-    connect(m_searchTimer, &QTimer::timeout, [this] {m_launcherInter->Search(m_searchText);});
+    connect(m_searchTimer, &QTimer::timeout, [this] {m_daemonSearchText = m_searchText; m_launcherInter->Search(m_searchText);});
+    connect(m_iconAtlasSaveTimer, &QTimer::timeout, this, &AppsManager::saveIconAtlas);
+    connect(m_iconRequestTimer, &QTimer::timeout, this, &AppsManager::processIconRequests);
+    connect(m_snapshotSaveTimer, &QTimer::timeout, this, &AppsManager::saveStartupSnapshot);
+    connect(m_itemChangedTimer, &QTimer::timeout, this, &AppsManager::processItemChanged);
+    connect(m_presetWatcher, &QFileSystemWatcher::fileChanged, this, &AppsManager::presetFileChanged);
+    connect(m_catalogPublishTimer, &QTimer::timeout, this, &AppsManager::publishCatalog);
+    // any change of apps republish the catalog, search results are not in it
+    connect(this, &AppsManager::dataChanged, this, [this] (const AppsListModel::AppCategory category) {
+        if (category != AppsListModel::Search)
+            m_catalogPublishTimer->start();
+    });
+    connect(this, &AppsManager::layoutChanged, m_catalogPublishTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(this, &AppsManager::itemInserted, m_catalogPublishTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(this, &AppsManager::itemRemoved, m_catalogPublishTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(this, &AppsManager::itemDataChanged, m_catalogPublishTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(m_desktopWatcher, &QFileSystemWatcher::directoryChanged, this, [this] {m_desktopFilesValid = false; m_catalogPublishTimer->start();});
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &AppsManager::saveIconAtlas);
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &AppsManager::saveStartupSnapshot);
+    // connected after all saving slots, so they are written before quit
+    connect(qApp, &QCoreApplication::aboutToQuit, m_persistStore, &PersistStore::sync);
+
+    m_catalogPublishTimer->start();
 }
 
-const QPixmap AppsManager::loadSvg(const QString &fileName, const int size)
+///
+/// \brief AppsManager::loadSvg render svg file to image, this function is safe to call from worker threads
+///
+const QImage AppsManager::loadSvg(const QString &fileName, const int size)
 {
-    QPixmap pixmap(size, size);
+    QImage image(size, size, QImage::Format_ARGB32_Premultiplied);
     QSvgRenderer renderer(fileName);
-    pixmap.fill(Qt::transparent);
+    image.fill(Qt::transparent);
 
     QPainter painter;
-    painter.begin(&pixmap);
+    painter.begin(&image);
     renderer.render(&painter);
     painter.end();
 
-    return pixmap;
+    return image;
 }
 
-const QPixmap AppsManager::loadIconFile(const QString &fileName, const int size)
+///
+/// \brief AppsManager::loadIconFile load and scale icon file, this function is safe to call from worker threads
+///
+const QImage AppsManager::loadIconFile(const QString &fileName, const int size)
 {
-    QPixmap pixmap;
+    QImage image;
     if (fileName.startsWith("data:image/")) {
         //This icon file is an inline image
         QStringList strs = fileName.split("base64,");
         if (strs.length() == 2) {
             QByteArray data = QByteArray::fromBase64(strs.at(1).toLatin1());
-            pixmap.loadFromData(data);
+            image.loadFromData(data);
         }
 
     } else if (fileName.endsWith(".svg", Qt::CaseInsensitive))
-        pixmap = loadSvg(fileName, size);
+        image = loadSvg(fileName, size);
     else
-        pixmap = QPixmap(fileName);
+        image = QImage(fileName);
 
-    if (pixmap.isNull())
-        return pixmap;
+    if (image.isNull())
+        return image;
+
+    return image.scaled(size, size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
+
+const QPixmap AppsManager::defaultIcon(const int size)
+{
+    if (m_defaultIconPixmap.isNull() || m_defaultIconPixmap.width() != size)
+        m_defaultIconPixmap = QPixmap::fromImage(loadSvg(":/skin/images/application-default-icon.svg", size));
+
+    return m_defaultIconPixmap;
+}
+
+void AppsManager::saveIconAtlas()
+{
+    m_iconAtlasSaveTimer->stop();
+    m_iconAtlas.save();
+    ThemeAppIcon::saveThemeIconPaths();
+
+    // saved icons have atlas offsets now
+    m_catalogPublishTimer->start();
+}
+
+///
+/// \brief AppsManager::processIconRequests resolve theme icon path of queued requests, and render them in thread pool
+///
+void AppsManager::processIconRequests()
+{
+    const QList<QPair<QString, int>> requests = m_iconRequests;
+    m_iconRequests.clear();
+
+    for (const auto &request : requests)
+    {
+        const QString iconKey = request.first;
+        const int size = request.second;
+        const int generation = m_iconGeneration;
+
+        // gtk icon theme is not thread safe, resolve path in GUI thread.
+        const QString iconPath = m_themeAppIcon->getThemeIconPath(iconKey, size);
+
+        QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+        connect(watcher, &QFutureWatcher<QImage>::finished, this, [=] {
+            watcher->deleteLater();
+
+            // icon cache is refreshed during loading
+            if (generation != m_iconGeneration)
+                return;
+
+            iconLoaded(iconKey, size, watcher->result());
+        });
+        watcher->setFuture(QtConcurrent::run([iconPath, size] () -> QImage {
+            return loadIconFile(iconPath, size);
+        }));
+    }
+}
+
+void AppsManager::iconLoaded(const QString &iconKey, const int size, const QImage &image)
+{
+    const QString cacheKey = QString("%1-%2").arg(iconKey).arg(size);
+    m_loadingIcons.remove(cacheKey);
+
+    if (image.isNull())
+    {
+        // no need to try again, use default icon for this key
+        m_iconPixmapCache.insert(cacheKey, defaultIcon(size));
+    } else {
+        m_iconPixmapCache.insert(cacheKey, QPixmap::fromImage(image));
+        m_iconAtlas.insert(iconKey, size, image);
+        m_iconAtlasSaveTimer->start();
+    }
 
-    return pixmap.scaled(size, size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    emit iconChanged(iconKey);
 }
 
 void AppsManager::appendSearchResult(const QString &appKey)
 {
-    for (const ItemInfo &info : m_allAppInfoList)
-        if (info.m_key == appKey)
-            return m_appSearchResultList.append(info);
+    const ItemInfo *info = m_appsCatalog.find(appKey);
+    if (info)
+        m_appSearchResultList.append(*info);
 }
 
 void AppsManager::sortCategory(const AppsListModel::AppCategory category)
@@ -120,32 +289,96 @@ void AppsManager::sortCategory(const AppsListModel::AppCategory category)
 
 void AppsManager::sortByPresetOrder(ItemInfoList &processList)
 {
-    QVariant presetFallback = APP_PRESET_SORTED_LIST.value("list");
-    QString key = QString("list[%1]").arg(QLocale::system().name());
-    QStringList preset = APP_PRESET_SORTED_LIST.value(key, presetFallback).toStringList();
+    PERF_TRACE("AppsManager::sortByPresetOrder");
+
+    struct SortEntry {
+        int rank;
+        QCollatorSortKey nameKey;
+        int index;
+    };
+
+    const QHash<QString, int> &ranks = presetRanks();
+    m_appsCatalog.setCollationLocale(QLocale::system());
+
+    // decorate items with their rank and name collation key, so comparing is cheap.
+    // If one of them doesn't exist in the preset list, the one exists go first,
+    // and if both of them don't exist, fallback to comparing their name.
+    std::vector<SortEntry> entries;
+    entries.reserve(processList.size());
+    for (int i(0); i != processList.size(); ++i)
+        entries.push_back({ranks.value(processList[i].m_key, std::numeric_limits<int>::max()),
+                           m_appsCatalog.nameSortKey(processList[i]), i});
+
+    // stable, apps in the same order keep their rows
+    std::stable_sort(entries.begin(), entries.end(), [] (const SortEntry &e1, const SortEntry &e2) {
+        if (e1.rank != e2.rank)
+            return e1.rank < e2.rank;
+
+        return e1.nameKey.compare(e2.nameKey) < 0;
+    });
 
-    qSort(processList.begin(), processList.end(), [&preset] (const ItemInfo &i1, const ItemInfo &i2) {
-        int index1 = preset.indexOf(i1.m_key);
-        int index2 = preset.indexOf(i2.m_key);
+    ItemInfoList sortedList;
+    sortedList.reserve(processList.size());
+    for (const SortEntry &entry : entries)
+        sortedList.append(processList[entry.index]);
 
-        if (index1 == index2) {
-            // If both of them don't exist in the preset list,
-            // fallback to comparing their name.
-            return i1.m_name < i2.m_name;
-        }
+    processList.swap(sortedList);
+}
 
-        // If one of them doesn't exist in the preset list,
-        // the one exists go first.
-        if (index1 == -1) {
-            return false;
-        }
-        if (index2 == -1) {
-            return true;
-        }
+///
+/// \brief AppsManager::presetOrderLessThan comparator of apps in preset order, same as sortByPresetOrder uses
+/// \return the comparator, it's valid until apps catalog or preset order is changed
+///
+const std::function<bool (const ItemInfo &, const ItemInfo &)> AppsManager::presetOrderLessThan()
+{
+    const QHash<QString, int> &ranks = presetRanks();
+    m_appsCatalog.setCollationLocale(QLocale::system());
 
-        // If both of them exist, then obey the preset order.
-        return index1 < index2;
-    });
+    return [&ranks, this] (const ItemInfo &info1, const ItemInfo &info2) {
+        const int rank1 = ranks.value(info1.m_key, std::numeric_limits<int>::max());
+        const int rank2 = ranks.value(info2.m_key, std::numeric_limits<int>::max());
+        if (rank1 != rank2)
+            return rank1 < rank2;
+
+        return m_appsCatalog.nameSortKey(info1).compare(m_appsCatalog.nameSortKey(info2)) < 0;
+    };
+}
+
+///
+/// \brief AppsManager::presetRanks compile preset order of current locale to app key -> rank table
+/// \return the cached table, it is rebuilt when locale or preset file is changed
+///
+const QHash<QString, int> &AppsManager::presetRanks()
+{
+    const QString locale = QLocale::system().name();
+    if (m_presetRanksValid && m_presetRanksLocale == locale)
+        return m_presetRanks;
+
+    const QVariant presetFallback = APP_PRESET_SORTED_LIST.value("list");
+    const QString key = QString("list[%1]").arg(locale);
+    const QStringList preset = APP_PRESET_SORTED_LIST.value(key, presetFallback).toStringList();
+
+    m_presetRanks.clear();
+    m_presetRanks.reserve(preset.size());
+    for (int i(0); i != preset.size(); ++i)
+        if (!m_presetRanks.contains(preset[i]))
+            m_presetRanks.insert(preset[i], i);
+
+    m_presetRanksLocale = locale;
+    m_presetRanksValid = true;
+
+    return m_presetRanks;
+}
+
+void AppsManager::presetFileChanged()
+{
+    // file is replaced when package upgrading, watch the new one.
+    const QString fileName = APP_PRESET_SORTED_LIST.fileName();
+    if (!m_presetWatcher->files().contains(fileName) && QFile::exists(fileName))
+        m_presetWatcher->addPath(fileName);
+
+    APP_PRESET_SORTED_LIST.sync();
+    m_presetRanksValid = false;
 }
 
 AppsManager *AppsManager::instance(QObject *parent)
@@ -166,44 +399,36 @@ void AppsManager::stashItem(const QModelIndex &index)
 
 void AppsManager::stashItem(const QString &appKey)
 {
-    for (int i(0); i != m_allAppInfoList.size(); ++i)
-    {
-        if (m_allAppInfoList[i].m_key == appKey)
-        {
-            m_stashList.append(m_allAppInfoList[i]);
-            m_allAppInfoList.removeAt(i);
-            generateCategoryMap();
+    const ItemInfo *info = m_appsCatalog.find(appKey);
+    if (!info)
+        return;
 
-            return;
-        }
-    }
+    m_stashedApps.insert(appKey, *info);
+    m_appsCatalog.remove(appKey);
+    generateCategoryMap();
 }
 
 void AppsManager::abandonStashedItem(const QString &appKey)
 {
     //qDebug() << "bana" << appKey;
-    for (int i(0); i != m_stashList.size(); ++i)
-        if (m_stashList[i].m_key == appKey)
-            return m_stashList.removeAt(i);
+    m_stashedApps.remove(appKey);
 }
 
 void AppsManager::restoreItem(const QString &appKey, const int pos)
 {
-    for (int i(0); i != m_stashList.size(); ++i)
-    {
-        if (m_stashList[i].m_key == appKey)
-        {
-            // if pos is valid
-            if (pos != -1)
-                m_userSortedList.insert(pos, m_stashList[i]);
-            m_allAppInfoList.append(m_stashList[i]);
-            m_stashList.removeAt(i);
+    const auto it = m_stashedApps.find(appKey);
+    if (it == m_stashedApps.end())
+        return;
 
-            generateCategoryMap();
+    // if pos is valid
+    if (pos != -1)
+        m_userSortedList.insert(pos, it.value());
+    m_appsCatalog.insert(it.value());
+    m_stashedApps.erase(it);
 
-            return saveUserSortedList();
-        }
-    }
+    generateCategoryMap();
+
+    return saveUserSortedList();
 }
 
 int AppsManager::dockPosition() const
@@ -213,17 +438,80 @@ int AppsManager::dockPosition() const
 
 void AppsManager::saveUserSortedList()
 {
-    // save cache
-    QByteArray writeBuf;
-    QDataStream out(&writeBuf, QIODevice::WriteOnly);
-    out << m_userSortedList;
-    APP_USER_SORTED_LIST.setValue("list", writeBuf);
+    QStringList keys;
+    keys.reserve(m_userSortedList.size());
+    for (const ItemInfo &info : m_userSortedList)
+        keys << info.m_key;
+
+    // written behind, dragging items only updates memory
+    m_userSortedOrder.setKeys(keys);
+    m_persistStore->write(userSortedOrderFileName(), m_userSortedOrder.data());
 }
 
 void AppsManager::searchApp(const QString &keywords)
 {
-    m_searchTimer->start();
+    PERF_TRACE("AppsManager::searchApp");
+
     m_searchText = keywords;
+
+#ifdef WITH_DAEMON_SEARCH
+    m_searchTimer->start();
+#else
+    if (m_searchIndexDirty)
+        rebuildSearchIndex();
+
+    searchDone(m_searchIndex.search(keywords));
+
+    // daemon matches pinyin of Han names, which are not in local index
+    if (m_searchIndex.hasHanNames() && !keywords.trimmed().isEmpty())
+        m_searchTimer->start();
+#endif
+}
+
+void AppsManager::rebuildSearchIndex()
+{
+    m_searchIndex.setApps(m_appsCatalog.items(), m_searchTerms);
+    m_searchIndexDirty = false;
+
+    loadSearchTerms();
+}
+
+///
+/// \brief AppsManager::loadSearchTerms read search terms from desktop files of apps in thread pool, search again after loaded
+///
+void AppsManager::loadSearchTerms()
+{
+    if (m_searchTermsLoading)
+        return;
+
+    QStringList desktops;
+    for (const ItemInfo &info : m_appsCatalog.items())
+        if (!m_searchTerms.contains(info.m_desktop))
+            desktops.append(info.m_desktop);
+
+    if (desktops.isEmpty())
+        return;
+
+    m_searchTermsLoading = true;
+
+    QFutureWatcher<QHash<QString, QStringList>> *watcher = new QFutureWatcher<QHash<QString, QStringList>>(this);
+    connect(watcher, &QFutureWatcher<QHash<QString, QStringList>>::finished, this, [=] {
+        watcher->deleteLater();
+
+        m_searchTermsLoading = false;
+        m_searchTerms.unite(watcher->result());
+        m_searchIndexDirty = true;
+
+        if (!m_searchText.isEmpty())
+            searchApp(m_searchText);
+    });
+    watcher->setFuture(QtConcurrent::run([desktops] {
+        QHash<QString, QStringList> terms;
+        for (const QString &desktop : desktops)
+            terms.insert(desktop, AppsSearchIndex::desktopTerms(desktop));
+
+        return terms;
+    }));
 }
 
 void AppsManager::launchApp(const QModelIndex &index)
@@ -238,16 +526,6 @@ void AppsManager::launchApp(const QModelIndex &index)
 
 void AppsManager::uninstallApp(const QString &appKey)
 {
-    // refersh auto start cache
-    for (const ItemInfo &info : m_allAppInfoList)
-    {
-        if (info.m_key == appKey)
-        {
-            APP_AUTOSTART_CACHE.setValue(info.m_desktop, false);
-            break;
-        }
-    }
-
     // begin uninstall, remove icon first.
     stashItem(appKey);
 
@@ -257,7 +535,7 @@ void AppsManager::uninstallApp(const QString &appKey)
     emit dataChanged(AppsListModel::All);
 
     // refersh search result
-    m_searchTimer->start();
+    searchApp(m_searchText);
 }
 
 void AppsManager::markLaunched(QString appKey)
@@ -267,15 +545,87 @@ void AppsManager::markLaunched(QString appKey)
 
     m_newInstalledAppsList.removeOne(appKey);
     m_launcherInter->MarkLaunched(appKey);
+    m_snapshotSaveTimer->start();
+
+    emit dataChanged(AppsListModel::All);
 }
 
-//void AppsManager::dockedAppsChanged()
-//{
-//    m_dockedAppsList = m_dockedAppInter->dockedApps();
-//}
+///
+/// \brief AppsManager::dockedAppsChanged read docked apps property asynchronously
+///
+void AppsManager::dockedAppsChanged()
+{
+    QDBusMessage msg = QDBusMessage::createMethodCall(m_dockedAppInter->service(), m_dockedAppInter->path(),
+                                                      "org.freedesktop.DBus.Properties", "Get");
+    msg << m_dockedAppInter->interface() << "DockedApps";
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_dockedAppInter->connection().asyncCall(msg), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [=] {
+        watcher->deleteLater();
+
+        const QDBusPendingReply<QDBusVariant> reply = *watcher;
+        if (reply.isError())
+        {
+            qWarning() << "get docked apps failed" << reply.error().message();
+            return;
+        }
+
+        m_dockedAppsList.clear();
+        for (const QString &desktop : reply.value().variant().toStringList())
+            m_dockedAppsList.insert(desktopFileName(desktop));
+
+        m_catalogPublishTimer->start();
+    });
+}
 
-const ItemInfoList AppsManager::appsInfoList(const AppsListModel::AppCategory &category) const
+///
+/// \brief AppsManager::refreshDesktopFiles list files on desktop, and watch the desktop directory
+///
+void AppsManager::refreshDesktopFiles()
 {
+    const QString desktopPath = QStandardPaths::writableLocation(QStandardPaths::DesktopLocation);
+    if (!m_desktopWatcher->directories().contains(desktopPath))
+        m_desktopWatcher->addPath(desktopPath);
+
+    m_desktopFiles = QDir(desktopPath).entryList(QDir::AllEntries | QDir::System | QDir::NoDotAndDotDot).toSet();
+    m_desktopFilesValid = true;
+}
+
+///
+/// \brief AppsManager::publishCatalog write apps in user sorted order into shared catalog, and announce the new generation
+///
+void AppsManager::publishCatalog()
+{
+    const int iconSize = m_calUtil->appIconSize().width();
+
+    QVector<SharedCatalog::App> apps;
+    apps.reserve(m_userSortedList.size());
+    for (const ItemInfo &info : m_userSortedList)
+    {
+        quint32 flags = 0;
+        if (appIsAutoStart(info.m_desktop))
+            flags |= SharedCatalog::AutoStart;
+        if (appIsOnDock(info.m_desktop))
+            flags |= SharedCatalog::OnDock;
+        if (appIsOnDesktop(info.m_desktop))
+            flags |= SharedCatalog::OnDesktop;
+        if (appIsNewInstall(info.m_key))
+            flags |= SharedCatalog::NewInstall;
+
+        apps.append(SharedCatalog::App {&info, flags, m_iconAtlas.dataOffset(info.m_iconKey, iconSize)});
+    }
+
+    if (m_sharedCatalog.publish(apps, m_iconAtlas.fileName(), iconSize))
+        emit catalogPublished(m_sharedCatalog.key(), m_sharedCatalog.generation());
+}
+
+///
+/// \brief AppsManager::appsInfoList apps list of category, the reference is valid until apps list is changed
+///
+const ItemInfoList &AppsManager::appsInfoList(const AppsListModel::AppCategory &category) const
+{
+    static const ItemInfoList emptyList;
+
     switch (category)
     {
     case AppsListModel::Custom:
@@ -284,7 +634,11 @@ const ItemInfoList AppsManager::appsInfoList(const AppsListModel::AppCategory &c
     default:;
     }
 
-    return m_appInfos[category];
+    const auto it = m_appInfos.constFind(category);
+    if (it == m_appInfos.constEnd())
+        return emptyList;
+
+    return it.value();
 }
 
 bool AppsManager::appIsNewInstall(const QString &key)
@@ -294,56 +648,84 @@ bool AppsManager::appIsNewInstall(const QString &key)
 
 bool AppsManager::appIsAutoStart(const QString &desktop)
 {
-    if (APP_AUTOSTART_CACHE.contains(desktop))
-        return APP_AUTOSTART_CACHE.value(desktop).toBool();
-
-    const bool isAutoStart = m_startManagerInter->IsAutostart(desktop).value();
-
-    APP_AUTOSTART_CACHE.setValue(desktop, isAutoStart);
-
-    return isAutoStart;
+    return m_autoStartIndex.isAutostart(desktopFileName(desktop));
 }
 
 bool AppsManager::appIsOnDock(const QString &desktop)
 {
-//    qDebug() << m_dockedAppsList;
-//    return m_dockedAppsList.contains(appName);
-    return m_dockedAppInter->IsDocked(desktop);
+    return m_dockedAppsList.contains(desktopFileName(desktop));
 }
 
 bool AppsManager::appIsOnDesktop(const QString &desktop)
 {
-    return m_launcherInter->IsItemOnDesktop(desktop).value();
+    if (!m_desktopFilesValid)
+        refreshDesktopFiles();
+
+    return m_desktopFiles.contains(desktopFileName(desktop));
 }
 
 const QPixmap AppsManager::appIcon(const QString &iconKey, const int size)
 {
-    const QPixmap cachePixmap = APP_ICON_CACHE.value(QString("%1-%2").arg(iconKey).arg(size)).value<QPixmap>();
-    if (!cachePixmap.isNull())
-        return cachePixmap;
+    const QString cacheKey = QString("%1-%2").arg(iconKey).arg(size);
+    const auto cached = m_iconPixmapCache.constFind(cacheKey);
+    if (cached != m_iconPixmapCache.constEnd())
+        return cached.value();
 
-    const QString iconPath = m_themeAppIcon->getThemeIconPath(iconKey, size);
-    const QPixmap iconPixmap = loadIconFile(iconPath, size);
+    const QImage atlasImage = m_iconAtlas.image(iconKey, size);
+    if (!atlasImage.isNull())
+    {
+        // atlas image points to mapped memory which is unmapped on save, pixmap may share
+        // the image buffer, so it must own a copy of pixels
+        const QPixmap pixmap = QPixmap::fromImage(atlasImage.copy());
+        m_iconPixmapCache.insert(cacheKey, pixmap);
+        return pixmap;
+    }
 
-    if (!iconPixmap.isNull())
+    // load icon asynchronously, use default icon as placeholder.
+    if (!m_loadingIcons.contains(cacheKey))
     {
-        APP_ICON_CACHE.setValue(QString("%1-%2").arg(iconKey).arg(size), iconPixmap);
-        return iconPixmap;
+        m_loadingIcons.insert(cacheKey);
+        m_iconRequests.append(QPair<QString, int>(iconKey, size));
+        m_iconRequestTimer->start();
     }
 
-    if (m_defaultIconPixmap.isNull() || m_defaultIconPixmap.width() != size)
-        m_defaultIconPixmap = loadSvg(":/skin/images/application-default-icon.svg", size);
+    return defaultIcon(size);
+}
 
-    return m_defaultIconPixmap;
+///
+/// \brief AppsManager::loadUserSortedList read saved order, apps not in catalog are dropped
+///
+void AppsManager::loadUserSortedList()
+{
+    QStringList keys;
+    if (m_userSortedOrder.load(m_persistStore->read(userSortedOrderFileName())))
+    {
+        keys = m_userSortedOrder.keys();
+    } else {
+        // whole item infos are saved in QSettings by old versions
+        QByteArray readBuf = QSettings("deepin", "dde-launcher-app-sorted-list").value("list").toByteArray();
+        QDataStream in(&readBuf, QIODevice::ReadOnly);
+        ItemInfoList infoList;
+        in >> infoList;
+
+        for (const ItemInfo &info : infoList)
+            keys << info.m_key;
+    }
+
+    m_userSortedList.clear();
+    m_userSortedList.reserve(keys.size());
+    for (const QString &key : keys)
+    {
+        const ItemInfo *info = m_appsCatalog.find(key);
+        if (info)
+            m_userSortedList.append(*info);
+    }
 }
 
 void AppsManager::refreshCategoryInfoList()
 {
-    QByteArray readBuf = APP_USER_SORTED_LIST.value("list").toByteArray();
-    QDataStream in(&readBuf, QIODevice::ReadOnly);
-    in >> m_userSortedList;
-
-    m_allAppInfoList = m_launcherInter->GetAllItemInfos().value();
+    m_appsCatalog.reset(m_launcherInter->GetAllItemInfos().value());
+    loadUserSortedList();
 
     generateCategoryMap();
     saveUserSortedList();
@@ -351,26 +733,40 @@ void AppsManager::refreshCategoryInfoList()
 
 void AppsManager::generateCategoryMap()
 {
+    PERF_TRACE("AppsManager::generateCategoryMap");
+
     m_appInfos.clear();
-    sortByPresetOrder(m_allAppInfoList);
 
-    for (const ItemInfo &info : m_allAppInfoList)
+    ItemInfoList appInfoList = m_appsCatalog.items();
+    sortByPresetOrder(appInfoList);
+
+    // remove uninstalled app item, and refresh info of remaining apps
+    QSet<QString> sortedKeys;
+    sortedKeys.reserve(m_userSortedList.size());
+
+    ItemInfoList userSortedList;
+    userSortedList.reserve(m_userSortedList.size() + appInfoList.size());
+    for (const ItemInfo &info : m_userSortedList)
     {
-        // append new installed app to user sorted list
-        if (!m_userSortedList.contains(info))
-            m_userSortedList.append(info);
+        const ItemInfo *current = m_appsCatalog.find(info.m_key);
+        if (!current || sortedKeys.contains(info.m_key))
+            continue;
+
+        sortedKeys.insert(info.m_key);
+        userSortedList.append(*current);
+    }
 
-        const AppsListModel::AppCategory category = info.category();
-        if (!m_appInfos.contains(category))
-            m_appInfos.insert(category, ItemInfoList());
+    for (const ItemInfo &info : appInfoList)
+    {
+        // append new installed app to user sorted list
+        if (!sortedKeys.contains(info.m_key))
+            userSortedList.append(info);
 
-        m_appInfos[category].append(info);
+        m_appInfos[info.category()].append(info);
     }
 
-    // remove uninstalled app item
-    for (const ItemInfo &info : m_userSortedList)
-        if (!m_allAppInfoList.contains(info))
-            m_userSortedList.removeOne(info);
+    m_userSortedList = userSortedList;
+    m_searchIndexDirty = true;
 }
 
 int AppsManager::appNums(const AppsListModel::AppCategory &category) const
@@ -378,6 +774,26 @@ int AppsManager::appNums(const AppsListModel::AppCategory &category) const
     return appsInfoList(category).size();
 }
 
+///
+/// \brief AppsManager::appRow find row of app in user sorted list
+/// \param appKey app key
+/// \return row of app, or -1 if not found
+///
+int AppsManager::appRow(const QString &appKey) const
+{
+    const auto it = m_userSortedRows.constFind(appKey);
+    if (it != m_userSortedRows.constEnd() && it.value() < m_userSortedList.size() && m_userSortedList[it.value()].m_key == appKey)
+        return it.value();
+
+    // list is changed since last lookup, rebuild the index
+    m_userSortedRows.clear();
+    m_userSortedRows.reserve(m_userSortedList.size());
+    for (int i(0); i != m_userSortedList.size(); ++i)
+        m_userSortedRows.insert(m_userSortedList[i].m_key, i);
+
+    return m_userSortedRows.value(appKey, -1);
+}
+
 //void AppsManager::unInstallApp(const QModelIndex &index, int value) {
 //    QString appKey = index.data(AppsListModel::AppKeyRole).toString();
 //    if (value==1) {
@@ -430,8 +846,13 @@ int AppsManager::appNums(const AppsListModel::AppCategory &category) const
 
 void AppsManager::refreshAppIconCache()
 {
-    APP_ICON_CACHE.clear();
-    APP_ICON_CACHE.setValue("version", qApp->applicationVersion());
+    ++m_iconGeneration;
+    ThemeAppIcon::refreshThemeIconPaths();
+    m_iconRequests.clear();
+    m_loadingIcons.clear();
+    m_iconPixmapCache.clear();
+    m_iconAtlas.clear();
+    m_iconAtlasSaveTimer->start();
 //    return;
 
 //    int appIconSize = m_calUtil->appIconSize().width();
@@ -454,21 +875,172 @@ void AppsManager::refreshAppIconCache()
 //    emit dataChanged(AppsListModel::All);
 }
 
+///
+/// \brief AppsManager::refreshAppAutoStartCache scan autostart dirs, and update rows of apps whose autostart state is changed
+///
 void AppsManager::refreshAppAutoStartCache()
 {
-    APP_AUTOSTART_CACHE.setValue("version", qApp->applicationVersion());
+    m_autoStartTimer->stop();
+
+    const QSet<QString> changed = m_autoStartIndex.refresh();
+
+    // dirs are watched for added or removed files, files for changed content.
+    // watch parent dir if autostart dir is not created yet
+    QSet<QString> paths = m_autoStartIndex.files().toSet();
+    for (const QString &dir : AutostartIndex::autostartDirs())
+        paths.insert(QFileInfo(dir).isDir() ? dir : QFileInfo(dir).absolutePath());
+
+    const QSet<QString> watchedPaths = (m_autoStartWatcher->files() + m_autoStartWatcher->directories()).toSet();
+    const QSet<QString> removedPaths = watchedPaths - paths;
+    const QSet<QString> addedPaths = paths - watchedPaths;
+    if (!removedPaths.isEmpty())
+        m_autoStartWatcher->removePaths(removedPaths.toList());
+    if (!addedPaths.isEmpty())
+        m_autoStartWatcher->addPaths(addedPaths.toList());
+
+    if (changed.isEmpty())
+        return;
+
+    auto notifyChanged = [&] (const AppsListModel::AppCategory category, const ItemInfoList &list) {
+        for (int i(0); i != list.size(); ++i)
+            if (changed.contains(desktopFileName(list[i].m_desktop)))
+                emit itemDataChanged(category, i);
+    };
+
+    notifyChanged(AppsListModel::All, m_userSortedList);
+    notifyChanged(AppsListModel::Search, m_appSearchResultList);
+    for (auto it(m_appInfos.cbegin()); it != m_appInfos.cend(); ++it)
+        notifyChanged(it.key(), it.value());
+}
+
+///
+/// \brief AppsManager::loadStartupSnapshot load apps list saved by last running
+/// \return true if the snapshot is valid
+///
+bool AppsManager::loadStartupSnapshot()
+{
+    const QByteArray snapshot = m_persistStore->read(snapshotFileName());
+    if (snapshot.isEmpty())
+        return false;
+
+    quint32 magic = 0;
+    quint32 formatVersion = 0;
+    QString version;
+
+    QDataStream in(snapshot);
+    in >> magic >> formatVersion >> version;
+    if (magic != SnapshotMagic || formatVersion != SnapshotFormatVersion || version != qApp->applicationVersion())
+        return false;
+
+    ItemInfoList appInfoList;
+    QStringList newInstalledAppsList;
+    in >> appInfoList >> newInstalledAppsList;
+
+    if (in.status() != QDataStream::Ok || appInfoList.isEmpty())
+        return false;
+
+    m_appsCatalog.reset(appInfoList);
+    m_newInstalledAppsList = newInstalledAppsList;
+
+    return true;
+}
+
+void AppsManager::saveStartupSnapshot()
+{
+    m_snapshotSaveTimer->stop();
+
+    QByteArray snapshot;
+    QDataStream out(&snapshot, QIODevice::WriteOnly);
+    out << SnapshotMagic << SnapshotFormatVersion << qApp->applicationVersion();
+    out << m_appsCatalog.items() << m_newInstalledAppsList;
+
+    m_persistStore->write(snapshotFileName(), snapshot);
+}
+
+///
+/// \brief AppsManager::reconcileStartupSnapshot fetch apps list from daemon asynchronously, update views if snapshot is outdated
+///
+void AppsManager::reconcileStartupSnapshot()
+{
+    QDBusPendingCallWatcher *newInstalledWatcher = new QDBusPendingCallWatcher(m_launcherInter->GetAllNewInstalledApps(), this);
+    connect(newInstalledWatcher, &QDBusPendingCallWatcher::finished, this, [=] {
+        newInstalledWatcher->deleteLater();
+
+        const QDBusPendingReply<QStringList> reply = *newInstalledWatcher;
+        if (reply.isError())
+            return;
+
+        const QStringList newInstalledAppsList = reply.value();
+        if (newInstalledAppsList.toSet() == m_newInstalledAppsList.toSet())
+            return;
+
+        m_newInstalledAppsList = newInstalledAppsList;
+        m_snapshotSaveTimer->start();
+
+        emit dataChanged(AppsListModel::All);
+    });
+
+    QDBusPendingCallWatcher *itemInfosWatcher = new QDBusPendingCallWatcher(m_launcherInter->GetAllItemInfos(), this);
+    connect(itemInfosWatcher, &QDBusPendingCallWatcher::finished, this, [=] {
+        itemInfosWatcher->deleteLater();
+
+        const QDBusPendingReply<ItemInfoList> reply = *itemInfosWatcher;
+        if (reply.isError())
+        {
+            qWarning() << "fetch app list failed" << reply.error().message();
+            return;
+        }
+
+        updateAppInfoList(reply.value());
+    });
+}
+
+///
+/// \brief AppsManager::updateAppInfoList replace all apps list, views are only updated if apps are really changed
+/// \param appInfoList new apps list
+///
+void AppsManager::updateAppInfoList(const ItemInfoList &appInfoList)
+{
+    QSet<QString> keys;
+    keys.reserve(appInfoList.size());
 
-    for (const ItemInfo &info : m_allAppInfoList)
+    QSet<AppsListModel::AppCategory> changedCategories;
+    for (const ItemInfo &info : appInfoList)
     {
-        const bool isAutoStart = m_startManagerInter->IsAutostart(info.m_desktop).value();
-        APP_AUTOSTART_CACHE.setValue(info.m_desktop, isAutoStart);
+        keys.insert(info.m_key);
+
+        const ItemInfo *oldInfo = m_appsCatalog.find(info.m_key);
+        if (oldInfo && *oldInfo == info)
+            continue;
+
+        changedCategories.insert(info.category());
+        if (oldInfo)
+            changedCategories.insert(oldInfo->category());
     }
 
-    emit dataChanged(AppsListModel::All);
+    // apps not in new list are removed
+    if (keys.size() != m_appsCatalog.size() || !changedCategories.isEmpty())
+        for (const ItemInfo &info : m_appsCatalog.items())
+            if (!keys.contains(info.m_key))
+                changedCategories.insert(info.category());
+
+    if (changedCategories.isEmpty())
+        return;
+
+    m_appsCatalog.reset(appInfoList);
+    generateCategoryMap();
+    saveUserSortedList();
+    m_snapshotSaveTimer->start();
+
+    emit layoutChanged(AppsListModel::All);
+    for (const AppsListModel::AppCategory category : changedCategories)
+        emit updateCategoryView(category);
 }
 
 void AppsManager::searchDone(const QStringList &resultList)
 {
+    PERF_TRACE("AppsManager::searchDone");
+
     m_appSearchResultList.clear();
 
     for (const QString &key : resultList)
@@ -482,6 +1054,32 @@ void AppsManager::searchDone(const QStringList &resultList)
         emit requestHideTips();
 }
 
+///
+/// \brief AppsManager::mergeDaemonSearchResult append apps found by daemon but not by local index, e.g. matched by pinyin
+///
+void AppsManager::mergeDaemonSearchResult(const QStringList &resultList)
+{
+    // result of an older query, the newer one is requested
+    if (m_searchText.trimmed().isEmpty() || m_daemonSearchText != m_searchText)
+        return;
+
+    QSet<QString> keys;
+    keys.reserve(m_appSearchResultList.size());
+    for (const ItemInfo &info : m_appSearchResultList)
+        keys.insert(info.m_key);
+
+    const int size = m_appSearchResultList.size();
+    for (const QString &key : resultList)
+        if (!keys.contains(key))
+            appendSearchResult(key);
+
+    if (m_appSearchResultList.size() == size)
+        return;
+
+    emit dataChanged(AppsListModel::Search);
+    emit requestHideTips();
+}
+
 //void AppsManager::handleDragedApp(const QModelIndex &index, int nextNode) {
 //    qDebug() << "draged app";
 //    QString appKey = index.data(AppsListModel::AppKeyRole).toString();
@@ -515,16 +1113,225 @@ void AppsManager::searchDone(const QStringList &resultList)
 //    }
 //}
 
-// TODO: optimize
+///
+/// \brief AppsManager::handleItemChanged queue item changes, signals burst during package upgrading are merged
+/// \param operation "created", "deleted" or "updated"
+/// \param appInfo changed item
+///
 void AppsManager::handleItemChanged(const QString &operation, const ItemInfo &appInfo, qlonglong categoryNumber)
 {
     qDebug() << "in0" << operation << appInfo.m_name << "in2" << categoryNumber;
 
+    const QString &key = appInfo.m_key;
+    if (!m_changedItems.contains(key))
+        m_changedItemKeys.append(key);
     if (operation == "created")
-        m_newInstalledAppsList.append(appInfo.m_key);
+        m_createdItemKeys.insert(key);
 
-    refreshCategoryInfoList();
-    refreshAppIconCache();
+    // only the final state of item is useful.
+    m_changedItems[key] = QPair<QString, ItemInfo>(operation, appInfo);
+    m_itemChangedTimer->start();
+}
 
-    emit dataChanged(AppsListModel::All);
+void AppsManager::processItemChanged()
+{
+    const QStringList keys = m_changedItemKeys;
+    const QHash<QString, QPair<QString, ItemInfo>> changes = m_changedItems;
+    const QSet<QString> createdKeys = m_createdItemKeys;
+    m_changedItemKeys.clear();
+    m_changedItems.clear();
+    m_createdItemKeys.clear();
+
+    bool userListChanged = false;
+    for (const QString &key : keys)
+    {
+        const QPair<QString, ItemInfo> change = changes.value(key);
+        const QString &operation = change.first;
+        const ItemInfo &info = change.second;
+
+        const bool exists = m_appsCatalog.contains(key);
+
+        if (operation == "deleted")
+        {
+            m_stashedApps.remove(key);
+
+            if (!exists)
+                continue;
+
+            m_newInstalledAppsList.removeOne(key);
+            removeItem(key);
+            userListChanged = true;
+        }
+        else if (exists)
+        {
+            updateItem(info);
+        }
+        else
+        {
+            if (createdKeys.contains(key) && !m_newInstalledAppsList.contains(key))
+                m_newInstalledAppsList.append(key);
+            insertItem(info);
+            userListChanged = true;
+        }
+    }
+
+    if (userListChanged)
+        saveUserSortedList();
+    m_snapshotSaveTimer->start();
+
+    // refresh search result
+    if (!m_searchText.isEmpty())
+        searchApp(m_searchText);
+}
+
+void AppsManager::insertItem(const ItemInfo &info)
+{
+    m_appsCatalog.insert(info);
+    m_searchIndexDirty = true;
+
+    insertCategoryItem(info);
+
+    // new installed app is appended to user sorted list
+    const int row = m_userSortedList.size();
+    emit itemAboutToBeInserted(AppsListModel::All, row);
+    m_userSortedList.append(info);
+    emit itemInserted(AppsListModel::All);
+}
+
+void AppsManager::insertCategoryItem(const ItemInfo &info)
+{
+    const AppsListModel::AppCategory category = info.category();
+    ItemInfoList &categoryList = m_appInfos[category];
+
+    // insert after apps in the same order, rows of existing apps are never moved
+    const auto lessThan = presetOrderLessThan();
+    const int row = std::upper_bound(categoryList.cbegin(), categoryList.cend(), info, lessThan) - categoryList.cbegin();
+
+    emit itemAboutToBeInserted(category, row);
+    categoryList.insert(row, info);
+    emit itemInserted(category);
+
+    if (categoryList.size() == 1)
+        emit updateCategoryView(category);
+}
+
+void AppsManager::removeItem(const QString &appKey)
+{
+    const ItemInfo *found = m_appsCatalog.find(appKey);
+    if (found)
+    {
+        const ItemInfo info = *found;
+        m_appsCatalog.remove(appKey);
+        m_searchIndexDirty = true;
+        removeCategoryItem(info);
+        invalidateIcon(info.m_iconKey);
+    }
+
+    const int row = appRow(appKey);
+    if (row != -1)
+    {
+        emit itemAboutToBeRemoved(AppsListModel::All, row);
+        m_userSortedList.removeAt(row);
+        emit itemRemoved(AppsListModel::All);
+    }
+}
+
+void AppsManager::removeCategoryItem(const ItemInfo &info)
+{
+    const AppsListModel::AppCategory category = info.category();
+    if (!m_appInfos.contains(category))
+        return;
+
+    ItemInfoList &categoryList = m_appInfos[category];
+    for (int i(0); i != categoryList.size(); ++i)
+    {
+        if (categoryList[i].m_key != info.m_key)
+            continue;
+
+        emit itemAboutToBeRemoved(category, i);
+        categoryList.removeAt(i);
+        emit itemRemoved(category);
+        break;
+    }
+
+    if (categoryList.isEmpty())
+        emit updateCategoryView(category);
+}
+
+void AppsManager::updateItem(const ItemInfo &info)
+{
+    const ItemInfo *found = m_appsCatalog.find(info.m_key);
+    if (!found)
+        return;
+
+    const ItemInfo oldInfo = *found;
+    m_appsCatalog.insert(info);
+
+    // desktop file is changed, read search terms again.
+    m_searchTerms.remove(oldInfo.m_desktop);
+    m_searchIndexDirty = true;
+
+    // icon file may be replaced even if icon key is not changed.
+    invalidateIcon(oldInfo.m_iconKey);
+    if (oldInfo.m_iconKey != info.m_iconKey)
+        invalidateIcon(info.m_iconKey);
+
+    if (oldInfo == info)
+        return;
+
+    const int row = appRow(info.m_key);
+    if (row != -1)
+    {
+        m_userSortedList[row] = info;
+        emit itemDataChanged(AppsListModel::All, row);
+    }
+
+    if (oldInfo.category() != info.category())
+    {
+        removeCategoryItem(oldInfo);
+        insertCategoryItem(info);
+        return;
+    }
+
+    ItemInfoList &categoryList = m_appInfos[info.category()];
+    for (int i(0); i != categoryList.size(); ++i)
+    {
+        if (categoryList[i].m_key != info.m_key)
+            continue;
+
+        // renamed app may be out of order, move it
+        const auto lessThan = presetOrderLessThan();
+        if ((i > 0 && lessThan(info, categoryList[i - 1])) ||
+                (i + 1 < categoryList.size() && lessThan(categoryList[i + 1], info)))
+        {
+            removeCategoryItem(oldInfo);
+            insertCategoryItem(info);
+            return;
+        }
+
+        categoryList[i] = info;
+        emit itemDataChanged(info.category(), i);
+        break;
+    }
+}
+
+///
+/// \brief AppsManager::invalidateIcon drop all cached sizes of icon, it will be loaded again on next paint
+/// \param iconKey icon key of app item
+///
+void AppsManager::invalidateIcon(const QString &iconKey)
+{
+    const QString prefix = iconKey + '-';
+    for (auto it(m_iconPixmapCache.begin()); it != m_iconPixmapCache.end();)
+    {
+        if (it.key().startsWith(prefix) && it.key().lastIndexOf('-') == prefix.size() - 1)
+            it = m_iconPixmapCache.erase(it);
+        else
+            ++it;
+    }
+
+    m_iconAtlas.remove(iconKey);
+    m_iconAtlasSaveTimer->start();
+
+    emit iconChanged(iconKey);
 }
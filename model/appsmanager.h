@@ -2,6 +2,12 @@
 #define APPSMANAGER_H
 
 #include "appslistmodel.h"
+#include "appscatalog.h"
+#include "appssearchindex.h"
+#include "autostartindex.h"
+#include "appsorder.h"
+#include "iconatlas.h"
+#include "sharedcatalog.h"
 #include "dbuslauncher.h"
 #include "dbusfileinfo.h"
 #include "dbustartmanager.h"
@@ -9,6 +15,7 @@
 #include "dbusdisplay.h"
 #include "global_util/calculate_util.h"
 #include "global_util/themeappicon.h"
+#include "global_util/persiststore.h"
 
 #include <QMap>
 #include <QSettings>
@@ -19,12 +26,18 @@
 #include <QScreen>
 #include <QDBusArgument>
 #include <QList>
+#include <QSet>
+#include <QFileSystemWatcher>
+
+#include <functional>
 
 class CalculateUtil;
 class AppsManager : public QObject
 {
     Q_OBJECT
 
+    friend class LauncherBenchmark;
+
 public:
     static AppsManager *instance(QObject *parent = nullptr);
 
@@ -33,6 +46,9 @@ public:
     void abandonStashedItem(const QString &appKey);
     void restoreItem(const QString &appKey, const int pos = -1);
     int dockPosition() const;
+    const ItemInfoList &appsInfoList(const AppsListModel::AppCategory &category) const;
+    inline const QString catalogSegment() const {return m_sharedCatalog.key();}
+    inline quint64 catalogGeneration() const {return m_sharedCatalog.generation();}
 
 signals:
     void dataChanged(const AppsListModel::AppCategory category) const;
@@ -42,6 +58,13 @@ signals:
     void requestTips(const QString &tips) const;
     void requestHideTips() const;
     void dockPositionChanged() const;
+    void iconChanged(const QString &iconKey) const;
+    void itemAboutToBeInserted(const AppsListModel::AppCategory category, const int row) const;
+    void itemInserted(const AppsListModel::AppCategory category) const;
+    void itemAboutToBeRemoved(const AppsListModel::AppCategory category, const int row) const;
+    void itemRemoved(const AppsListModel::AppCategory category) const;
+    void itemDataChanged(const AppsListModel::AppCategory category, const int row) const;
+    void catalogPublished(const QString &segment, const qulonglong generation) const;
 
 public slots:
     void refreshAppIconCache();
@@ -49,7 +72,6 @@ public slots:
     void searchApp(const QString &keywords);
     void launchApp(const QModelIndex &index);
     void uninstallApp(const QString &appKey);
-    const ItemInfoList appsInfoList(const AppsListModel::AppCategory &category) const;
 
     bool appIsNewInstall(const QString &key);
     bool appIsAutoStart(const QString &desktop);
@@ -57,6 +79,7 @@ public slots:
     bool appIsOnDesktop(const QString &desktop);
     const QPixmap appIcon(const QString &iconKey, const int size);
     int appNums(const AppsListModel::AppCategory &category) const;
+    int appRow(const QString &appKey) const;
 
     //remove the item icon firstly, when unInstalling apps
 //    void unInstallApp(const QModelIndex &index, int value);
@@ -66,25 +89,48 @@ public slots:
 //    void handleDragedApp(const QModelIndex &index, int nextNode);
 //    void handleDropedApp(const QModelIndex &index);
 
-    // TODO: optimize
     void handleItemChanged(const QString &operation, const ItemInfo &appInfo, qlonglong categoryNumber);
 
 private:
     explicit AppsManager(QObject *parent = 0);
 
-    const QPixmap loadSvg(const QString &fileName, const int size);
-    const QPixmap loadIconFile(const QString &fileName, const int size);
+    static const QImage loadSvg(const QString &fileName, const int size);
+    static const QImage loadIconFile(const QString &fileName, const int size);
+    const QPixmap defaultIcon(const int size);
+    void saveIconAtlas();
+    void processIconRequests();
+    void iconLoaded(const QString &iconKey, const int size, const QImage &image);
     void appendSearchResult(const QString &appKey);
+    void rebuildSearchIndex();
+    void loadSearchTerms();
     void sortCategory(const AppsListModel::AppCategory category);
     void sortByPresetOrder(ItemInfoList &processList);
+    const std::function<bool (const ItemInfo &, const ItemInfo &)> presetOrderLessThan();
+    const QHash<QString, int> &presetRanks();
+    void presetFileChanged();
+    void loadUserSortedList();
     void refreshCategoryInfoList();
     void generateCategoryMap();
     void refreshAppAutoStartCache();
+    bool loadStartupSnapshot();
+    void saveStartupSnapshot();
+    void reconcileStartupSnapshot();
+    void updateAppInfoList(const ItemInfoList &appInfoList);
+    void processItemChanged();
+    void insertItem(const ItemInfo &info);
+    void insertCategoryItem(const ItemInfo &info);
+    void removeItem(const QString &appKey);
+    void removeCategoryItem(const ItemInfo &info);
+    void updateItem(const ItemInfo &info);
+    void invalidateIcon(const QString &iconKey);
+    void refreshDesktopFiles();
+    void publishCatalog();
 
 private slots:
     void searchDone(const QStringList &resultList);
+    void mergeDaemonSearchResult(const QStringList &resultList);
     void markLaunched(QString appKey);
-//    void dockedAppsChanged();
+    void dockedAppsChanged();
 
 private:
     DBusLauncher *m_launcherInter;
@@ -93,12 +139,21 @@ private:
 
     QPixmap m_defaultIconPixmap;
     QString m_searchText;
+    // last query sent to daemon
+    QString m_daemonSearchText;
     QStringList m_newInstalledAppsList;
-//    QStringList m_dockedAppsList;
-    ItemInfoList m_allAppInfoList;
+    // file names of docked apps and files on desktop
+    QSet<QString> m_dockedAppsList;
+    QSet<QString> m_desktopFiles;
+    bool m_desktopFilesValid = false;
+    AppsCatalog m_appsCatalog;
     ItemInfoList m_userSortedList;
+    // saved order of m_userSortedList
+    AppsOrder m_userSortedOrder;
     ItemInfoList m_appSearchResultList;
-    ItemInfoList m_stashList;
+    QHash<QString, ItemInfo> m_stashedApps;
+    // app key -> row in m_userSortedList, validated and rebuilt on lookup
+    mutable QHash<QString, int> m_userSortedRows;
     QMap<AppsListModel::AppCategory, ItemInfoList> m_appInfos;
 
     ItemInfo m_unInstallItem = ItemInfo();
@@ -106,13 +161,45 @@ private:
 
     ThemeAppIcon* m_themeAppIcon;
     CalculateUtil *m_calUtil;
+    PersistStore *m_persistStore;
     QTimer *m_searchTimer;
+    QTimer *m_iconAtlasSaveTimer;
+    QTimer *m_iconRequestTimer;
+    QTimer *m_snapshotSaveTimer;
+    QTimer *m_itemChangedTimer;
+    QFileSystemWatcher *m_presetWatcher;
+    QFileSystemWatcher *m_desktopWatcher;
+    QFileSystemWatcher *m_autoStartWatcher;
+    QTimer *m_autoStartTimer;
+    QTimer *m_catalogPublishTimer;
+
+    IconAtlas m_iconAtlas;
+    QHash<QString, QPixmap> m_iconPixmapCache;
+    QList<QPair<QString, int>> m_iconRequests;
+    QSet<QString> m_loadingIcons;
+    int m_iconGeneration = 0;
+
+    AutostartIndex m_autoStartIndex;
+    SharedCatalog m_sharedCatalog;
+
+    AppsSearchIndex m_searchIndex;
+    bool m_searchIndexDirty = true;
+    bool m_searchTermsLoading = false;
+    // desktop file -> extra search terms
+    QHash<QString, QStringList> m_searchTerms;
+
+    // preset order of apps, app key -> rank
+    bool m_presetRanksValid = false;
+    QString m_presetRanksLocale;
+    QHash<QString, int> m_presetRanks;
+
+    // coalesced ItemChanged signals, key -> (operation, item info)
+    QStringList m_changedItemKeys;
+    QHash<QString, QPair<QString, ItemInfo>> m_changedItems;
+    QSet<QString> m_createdItemKeys;
 
     static AppsManager *INSTANCE;
-    static QSettings APP_ICON_CACHE;
-    static QSettings APP_AUTOSTART_CACHE;
     static QSettings APP_PRESET_SORTED_LIST;
-    static QSettings APP_USER_SORTED_LIST;
 };
 
 #endif // APPSMANAGER_H
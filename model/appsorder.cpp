@@ -0,0 +1,158 @@
+#include "appsorder.h"
+
+#include <QtEndian>
+
+#include <string.h>
+
+static const quint32 OrderMagic = 0x4f414444; // "DDAO"
+static const quint32 OrderFormatVersion = 1;
+static const quint32 OrderHeaderSize = 20;
+
+static inline quint32 readUInt32(const QByteArray &data, const quint32 offset)
+{
+    return qFromLittleEndian<quint32>(reinterpret_cast<const uchar *>(data.constData() + offset));
+}
+
+static inline void writeUInt32(QByteArray &data, const quint32 offset, const quint32 value)
+{
+    qToLittleEndian<quint32>(value, reinterpret_cast<uchar *>(data.data() + offset));
+}
+
+///
+/// \brief AppsOrder::load parse order data
+/// \return false if data is broken or in unknown format, the order is not changed
+///
+bool AppsOrder::load(const QByteArray &data)
+{
+    const quint32 size = data.size();
+    if (size < OrderHeaderSize || readUInt32(data, 0) != OrderMagic || readUInt32(data, 4) != OrderFormatVersion)
+        return false;
+
+    const quint32 keyCount = readUInt32(data, 8);
+    const quint32 count = readUInt32(data, 12);
+    const quint32 positionsOffset = readUInt32(data, 16);
+    if (positionsOffset < OrderHeaderSize || positionsOffset > size || quint64(count) * 4 != size - positionsOffset)
+        return false;
+
+    QStringList table;
+    quint32 offset = OrderHeaderSize;
+    for (quint32 i(0); i != keyCount; ++i)
+    {
+        if (offset + 4 > positionsOffset)
+            return false;
+
+        const quint32 length = readUInt32(data, offset);
+        offset += 4;
+        if (length > positionsOffset - offset)
+            return false;
+
+        table << QString::fromUtf8(data.constData() + offset, length);
+        offset += length;
+    }
+
+    QStringList keys;
+    QVector<quint32> positions(count);
+    keys.reserve(count);
+    for (quint32 i(0); i != count; ++i)
+    {
+        positions[i] = readUInt32(data, positionsOffset + i * 4);
+        if (positions[i] >= keyCount)
+            return false;
+
+        keys << table[positions[i]];
+    }
+
+    m_keys = keys;
+    m_table.clear();
+    m_table.reserve(keyCount);
+    for (quint32 i(0); i != keyCount; ++i)
+        m_table.insert(table[i], i);
+    m_positions = positions;
+    m_positionsOffset = positionsOffset;
+    m_data = data;
+
+    return true;
+}
+
+///
+/// \brief AppsOrder::setKeys set sorted keys, data is patched if keys are only reordered
+///
+void AppsOrder::setKeys(const QStringList &keys)
+{
+    if (keys == m_keys)
+        return;
+
+    if (!patch(keys))
+        rebuild(keys);
+
+    m_keys = keys;
+}
+
+bool AppsOrder::patch(const QStringList &keys)
+{
+    const int count = m_positions.size();
+    if (keys.size() != count || m_table.size() != count)
+        return false;
+
+    // must be a permutation of current keys
+    QVector<quint32> positions(count);
+    QVector<bool> used(count, false);
+    for (int i(0); i != count; ++i)
+    {
+        const auto it = m_table.constFind(keys[i]);
+        if (it == m_table.cend() || used[it.value()])
+            return false;
+
+        used[it.value()] = true;
+        positions[i] = it.value();
+    }
+
+    for (int i(0); i != count; ++i)
+    {
+        if (positions[i] == m_positions[i])
+            continue;
+
+        m_positions[i] = positions[i];
+        writeUInt32(m_data, m_positionsOffset + i * 4, positions[i]);
+    }
+
+    return true;
+}
+
+void AppsOrder::rebuild(const QStringList &keys)
+{
+    m_table.clear();
+    m_positions.clear();
+    m_table.reserve(keys.size());
+    m_positions.reserve(keys.size());
+
+    QByteArray table;
+    for (const QString &key : keys)
+    {
+        auto it = m_table.constFind(key);
+        if (it == m_table.cend())
+        {
+            const QByteArray utf8 = key.toUtf8();
+            QByteArray length(4, '\0');
+            writeUInt32(length, 0, utf8.size());
+            table.append(length).append(utf8);
+
+            it = m_table.insert(key, m_table.size());
+        }
+
+        m_positions.append(it.value());
+    }
+
+    const quint32 count = m_positions.size();
+    m_positionsOffset = OrderHeaderSize + table.size();
+
+    m_data = QByteArray(m_positionsOffset + count * 4, '\0');
+    writeUInt32(m_data, 0, OrderMagic);
+    writeUInt32(m_data, 4, OrderFormatVersion);
+    writeUInt32(m_data, 8, m_table.size());
+    writeUInt32(m_data, 12, count);
+    writeUInt32(m_data, 16, m_positionsOffset);
+    memcpy(m_data.data() + OrderHeaderSize, table.constData(), table.size());
+    for (quint32 i(0); i != count; ++i)
+        writeUInt32(m_data, m_positionsOffset + i * 4, m_positions[i]);
+}
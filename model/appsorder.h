@@ -0,0 +1,43 @@
+#ifndef APPSORDER_H
+#define APPSORDER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+///
+/// \brief The AppsOrder class is the binary user sort order of apps
+///
+/// layout of the order data, all numbers are little endian uint32:
+///   magic, formatVersion, keyCount, positionCount, positionsOffset
+///   keys[keyCount]            interned app keys, utf-8 length followed by bytes
+///   positions[positionCount]  key index of each position, starts at positionsOffset
+///
+/// the serialized data is kept, when apps are only moved the key table is
+/// reused and only changed positions are patched.
+///
+class AppsOrder
+{
+public:
+    bool load(const QByteArray &data);
+    void setKeys(const QStringList &keys);
+
+    inline const QStringList &keys() const {return m_keys;}
+    inline const QByteArray &data() const {return m_data;}
+
+private:
+    bool patch(const QStringList &keys);
+    void rebuild(const QStringList &keys);
+
+private:
+    // keys in sorted order
+    QStringList m_keys;
+    // key -> index in key table
+    QHash<QString, quint32> m_table;
+    QVector<quint32> m_positions;
+    quint32 m_positionsOffset = 0;
+    QByteArray m_data;
+};
+
+#endif // APPSORDER_H
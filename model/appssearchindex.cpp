@@ -0,0 +1,256 @@
+#include "appssearchindex.h"
+
+#include <QFileInfo>
+#include <QSet>
+
+#include <algorithm>
+
+#undef signals
+extern "C" {
+    #include <gio/gdesktopappinfo.h>
+}
+#define signals public
+
+static const int NamePrefixScore = 1000;
+static const int NameWordPrefixScore = 800;
+static const int NameSubstringScore = 600;
+static const int TermPrefixScore = 500;
+static const int TermSubstringScore = 400;
+static const int NameSubsequenceScore = 200;
+
+static inline const QString normalized(const QString &text)
+{
+    return text.trimmed().toCaseFolded();
+}
+
+///
+/// \brief foldName normalize name, and find the beginning of words in normalized name, include camel case words
+/// \param text original text, case is needed to find camel case words
+/// \param starts offsets of words in normalized name
+/// \return normalized name, same as normalized(text)
+///
+static const QString foldName(const QString &text, QVector<int> *starts)
+{
+    const QString trimmed = text.trimmed();
+
+    // case folding may change length, e.g. "ß" -> "ss", fold characters one by one to track offsets
+    QString folded;
+    folded.reserve(trimmed.size());
+    for (int i(0); i < trimmed.size(); ++i)
+    {
+        const QChar current = trimmed[i];
+        const int length = current.isHighSurrogate() && i + 1 < trimmed.size() ? 2 : 1;
+
+        if (i > 0 && current.isLetterOrNumber())
+        {
+            const QChar prev = trimmed[i - 1];
+            if (!prev.isLetterOrNumber() || (prev.isLower() && current.isUpper()))
+                starts->append(folded.size());
+        }
+
+        folded.append(trimmed.mid(i, length).toCaseFolded());
+        i += length - 1;
+    }
+
+    return folded;
+}
+
+///
+/// \brief subsequenceGaps match query as subsequence of text
+/// \return count of unmatched characters between the first and last matched ones, or -1 if not matched
+///
+static int subsequenceGaps(const QString &text, const QString &query)
+{
+    int first = -1;
+    int pos = -1;
+    for (const QChar &c : query)
+    {
+        pos = text.indexOf(c, pos + 1);
+        if (pos == -1)
+            return -1;
+        if (first == -1)
+            first = pos;
+    }
+
+    return pos - first + 1 - query.size();
+}
+
+void AppsSearchIndex::setApps(const ItemInfoList &apps, const QHash<QString, QStringList> &desktopTerms)
+{
+    clear();
+
+    m_documents.reserve(apps.size());
+    for (const ItemInfo &info : apps)
+    {
+        Document doc;
+        doc.key = info.m_key;
+        doc.name = foldName(info.m_name, &doc.wordStarts);
+        doc.terms << normalized(info.m_key)
+                  << normalized(QFileInfo(info.m_desktop).completeBaseName());
+        for (const QString &term : desktopTerms.value(info.m_desktop))
+            doc.terms << normalized(term);
+        doc.terms.removeAll(QString());
+        doc.terms.removeDuplicates();
+
+        const int index = m_documents.size();
+        QSet<QChar> chars;
+        for (const QChar &c : doc.name)
+        {
+            chars.insert(c);
+            if (c.script() == QChar::Script_Han)
+                m_hasHanNames = true;
+        }
+        for (const QString &term : doc.terms)
+            for (const QChar &c : term)
+                chars.insert(c);
+        for (const QChar &c : chars)
+            m_charIndex[c].append(index);
+
+        m_documents.append(doc);
+    }
+}
+
+void AppsSearchIndex::clear()
+{
+    m_documents.clear();
+    m_hasHanNames = false;
+    m_charIndex.clear();
+    m_lastQuery.clear();
+    m_lastMatches.clear();
+}
+
+///
+/// \brief AppsSearchIndex::search find apps match keywords
+/// \param keywords search text
+/// \return keys of matched apps, best matched first
+///
+const QStringList AppsSearchIndex::search(const QString &keywords)
+{
+    const QString query = normalized(keywords);
+    if (query.isEmpty())
+    {
+        m_lastQuery.clear();
+        m_lastMatches.clear();
+        return QStringList();
+    }
+
+    QVector<int> candidates;
+    if (!m_lastQuery.isEmpty() && query.startsWith(m_lastQuery))
+    {
+        // refine last results
+        candidates = m_lastMatches;
+    } else {
+        // every character of query must appear in matched apps, start from the rarest one
+        const QVector<int> *rarest = nullptr;
+        for (const QChar &c : query)
+        {
+            const auto it = m_charIndex.constFind(c);
+            if (it == m_charIndex.constEnd())
+            {
+                rarest = nullptr;
+                candidates.clear();
+                break;
+            }
+            if (!rarest || it.value().size() < rarest->size())
+                rarest = &it.value();
+        }
+
+        if (rarest)
+            candidates = *rarest;
+    }
+
+    QVector<QPair<int, int>> matches;
+    matches.reserve(candidates.size());
+    for (const int index : candidates)
+    {
+        const int s = score(m_documents[index], query);
+        if (s)
+            matches.append(QPair<int, int>(s, index));
+    }
+
+    m_lastQuery = query;
+    m_lastMatches.clear();
+    m_lastMatches.reserve(matches.size());
+    for (const auto &match : matches)
+        m_lastMatches.append(match.second);
+
+    std::sort(matches.begin(), matches.end(), [this] (const QPair<int, int> &m1, const QPair<int, int> &m2) {
+        if (m1.first != m2.first)
+            return m1.first > m2.first;
+
+        return m_documents[m1.second].name < m_documents[m2.second].name;
+    });
+
+    QStringList result;
+    result.reserve(matches.size());
+    for (const auto &match : matches)
+        result.append(m_documents[match.second].key);
+
+    return result;
+}
+
+///
+/// \brief AppsSearchIndex::desktopTerms read searchable fields from desktop file, this function is safe to call from worker threads
+/// \param desktop desktop file path
+/// \return untranslated name, generic name and keywords
+///
+const QStringList AppsSearchIndex::desktopTerms(const QString &desktop)
+{
+    QStringList terms;
+
+    GDesktopAppInfo *appInfo = g_desktop_app_info_new_from_filename(desktop.toUtf8().constData());
+    if (!appInfo)
+        return terms;
+
+    char *name = g_desktop_app_info_get_string(appInfo, G_KEY_FILE_DESKTOP_KEY_NAME);
+    if (name)
+        terms << QString::fromUtf8(name);
+    g_free(name);
+
+    const char *genericName = g_desktop_app_info_get_generic_name(appInfo);
+    if (genericName)
+        terms << QString::fromUtf8(genericName);
+
+    const char * const *keywords = g_desktop_app_info_get_keywords(appInfo);
+    for (int i(0); keywords && keywords[i]; ++i)
+        terms << QString::fromUtf8(keywords[i]);
+
+    g_object_unref(appInfo);
+
+    return terms;
+}
+
+///
+/// \brief AppsSearchIndex::score rate how well the document matches query
+/// \return 0 if not matched
+///
+int AppsSearchIndex::score(const Document &doc, const QString &query) const
+{
+    // shorter names are better matches in the same tier
+    const int lengthPenalty = qMin(doc.name.size(), 99);
+
+    if (doc.name.startsWith(query))
+        return NamePrefixScore - lengthPenalty;
+
+    for (const int start : doc.wordStarts)
+        if (doc.name.midRef(start).startsWith(query))
+            return NameWordPrefixScore - lengthPenalty;
+
+    const int pos = doc.name.indexOf(query);
+    if (pos != -1)
+        return NameSubstringScore - qMin(pos, 99);
+
+    for (const QString &term : doc.terms)
+        if (term.startsWith(query))
+            return TermPrefixScore - lengthPenalty;
+
+    for (const QString &term : doc.terms)
+        if (term.contains(query))
+            return TermSubstringScore - lengthPenalty;
+
+    const int gaps = subsequenceGaps(doc.name, query);
+    if (gaps != -1)
+        return qMax(1, NameSubsequenceScore - gaps);
+
+    return 0;
+}
@@ -0,0 +1,54 @@
+#ifndef APPSSEARCHINDEX_H
+#define APPSSEARCHINDEX_H
+
+#include "dbusinterface/dbusvariant/iteminfo.h"
+
+#include <QHash>
+#include <QVector>
+#include <QStringList>
+
+///
+/// \brief The AppsSearchIndex class searches apps locally without asking the daemon
+///
+/// every app is indexed by its name, key, desktop file name and extra terms read
+/// from desktop file (untranslated name, generic name and keywords). a query is
+/// matched in these tiers, from high to low score:
+///   name prefix > name word prefix > name substring > term prefix > term substring > name subsequence
+///
+/// a longer query can only match apps matched by its prefix, so typing more
+/// characters only rescans the last results.
+///
+/// pinyin of Han names is not indexed, hasHanNames() tells the caller whether
+/// the daemon should be asked too.
+///
+class AppsSearchIndex
+{
+public:
+    void setApps(const ItemInfoList &apps, const QHash<QString, QStringList> &desktopTerms);
+    void clear();
+    const QStringList search(const QString &keywords);
+    inline bool hasHanNames() const {return m_hasHanNames;}
+
+    static const QStringList desktopTerms(const QString &desktop);
+
+private:
+    struct Document {
+        QString key;
+        QString name;
+        QVector<int> wordStarts;
+        QStringList terms;
+    };
+
+    int score(const Document &doc, const QString &query) const;
+
+private:
+    QVector<Document> m_documents;
+    bool m_hasHanNames = false;
+    // character -> documents contain it
+    QHash<QChar, QVector<int>> m_charIndex;
+
+    QString m_lastQuery;
+    QVector<int> m_lastMatches;
+};
+
+#endif // APPSSEARCHINDEX_H
@@ -0,0 +1,99 @@
+#include "autostartindex.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QTextStream>
+#include <QStandardPaths>
+
+///
+/// \brief AutostartIndex::autostartDirs user autostart dir first, then system dirs
+///
+const QStringList AutostartIndex::autostartDirs()
+{
+    QStringList dirs;
+    for (const QString &configDir : QStandardPaths::standardLocations(QStandardPaths::GenericConfigLocation))
+        dirs << configDir + "/autostart";
+
+    return dirs;
+}
+
+///
+/// \brief AutostartIndex::refresh scan autostart dirs again
+/// \return file names whose autostart state is changed
+///
+const QSet<QString> AutostartIndex::refresh()
+{
+    QHash<QString, Entry> files;
+    QSet<QString> enabled;
+    QSet<QString> fileNames;
+
+    for (const QString &dir : autostartDirs())
+    {
+        for (const QFileInfo &info : QDir(dir).entryInfoList(QStringList() << "*.desktop", QDir::Files))
+        {
+            // hidden by the file in higher priority dir
+            if (fileNames.contains(info.fileName()))
+                continue;
+            fileNames.insert(info.fileName());
+
+            const qint64 modified = info.lastModified().toMSecsSinceEpoch();
+            const auto it = m_files.constFind(info.absoluteFilePath());
+
+            Entry entry;
+            if (it != m_files.cend() && it->size == info.size() && it->modified == modified)
+                entry = it.value();
+            else
+                entry = Entry {info.size(), modified, readEnabled(info.absoluteFilePath())};
+
+            files.insert(info.absoluteFilePath(), entry);
+            if (entry.enabled)
+                enabled.insert(info.fileName());
+        }
+    }
+
+    const QSet<QString> changed = (enabled - m_enabled) + (m_enabled - enabled);
+
+    m_files = files;
+    m_enabled = enabled;
+
+    return changed;
+}
+
+bool AutostartIndex::readEnabled(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return false;
+
+    QTextStream in(&file);
+    in.setCodec("UTF-8");
+
+    bool inDesktopEntry = false;
+    while (!in.atEnd())
+    {
+        const QString line = in.readLine().trimmed();
+        if (line.startsWith('['))
+        {
+            inDesktopEntry = line == "[Desktop Entry]";
+            continue;
+        }
+
+        if (!inDesktopEntry)
+            continue;
+
+        const int equal = line.indexOf('=');
+        if (equal == -1)
+            continue;
+
+        const QString key = line.left(equal).trimmed();
+        const QString value = line.mid(equal + 1).trimmed();
+        if (key == "Hidden" && value == "true")
+            return false;
+        if (key == "X-GNOME-Autostart-enabled" && value == "false")
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,41 @@
+#ifndef AUTOSTARTINDEX_H
+#define AUTOSTARTINDEX_H
+
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+
+///
+/// \brief The AutostartIndex class knows which desktop files are started on login, by scanning XDG autostart dirs
+///
+/// a desktop file in user autostart dir hides the one with same file name in
+/// system dirs. an entry is disabled if it has Hidden=true or
+/// X-GNOME-Autostart-enabled=false. files are parsed again only if their size
+/// or modified time is changed.
+///
+class AutostartIndex
+{
+public:
+    static const QStringList autostartDirs();
+
+    const QSet<QString> refresh();
+    inline bool isAutostart(const QString &fileName) const {return m_enabled.contains(fileName);}
+    inline const QStringList files() const {return m_files.keys();}
+
+private:
+    struct Entry {
+        qint64 size;
+        qint64 modified;
+        bool enabled;
+    };
+
+    static bool readEnabled(const QString &fileName);
+
+private:
+    // path of desktop file -> parsed entry
+    QHash<QString, Entry> m_files;
+    // file names of enabled desktop files
+    QSet<QString> m_enabled;
+};
+
+#endif // AUTOSTARTINDEX_H
@@ -0,0 +1,328 @@
+#include "groupedappsmodel.h"
+#include "appsmanager.h"
+#include "global_util/util.h"
+
+#include <algorithm>
+
+GroupedAppsModel::GroupedAppsModel(QObject *parent) :
+    QAbstractListModel(parent),
+    m_appsManager(AppsManager::instance(this))
+{
+    const QList<AppsListModel::AppCategory> categories = {
+        AppsListModel::Internet,
+        AppsListModel::Chat,
+        AppsListModel::Music,
+        AppsListModel::Video,
+        AppsListModel::Graphics,
+        AppsListModel::Game,
+        AppsListModel::Office,
+        AppsListModel::Reading,
+        AppsListModel::Development,
+        AppsListModel::System,
+        AppsListModel::Others,
+    };
+
+    for (const AppsListModel::AppCategory category : categories)
+    {
+        AppsListModel *model = new AppsListModel(category, this);
+        const int source = m_sources.size();
+        m_sources.append(model);
+
+        connect(model, &QAbstractItemModel::dataChanged, this, [=] (const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles) {
+            sourceDataChanged(source, topLeft, bottomRight, roles);
+        });
+    }
+
+    // source models are connected to appsManager first, they are always updated before this model
+    connect(m_appsManager, &AppsManager::dataChanged, this, &GroupedAppsModel::dataChanged);
+    connect(m_appsManager, &AppsManager::layoutChanged, this, &GroupedAppsModel::layoutChanged);
+    connect(m_appsManager, &AppsManager::itemAboutToBeInserted, this, &GroupedAppsModel::itemAboutToBeInserted);
+    connect(m_appsManager, &AppsManager::itemInserted, this, &GroupedAppsModel::itemInserted);
+    connect(m_appsManager, &AppsManager::itemAboutToBeRemoved, this, &GroupedAppsModel::itemAboutToBeRemoved);
+    connect(m_appsManager, &AppsManager::itemRemoved, this, &GroupedAppsModel::itemRemoved);
+
+    rebuildSections();
+}
+
+///
+/// \brief GroupedAppsModel::sectionOf find section contains row
+/// \param row row of this model
+/// \return section index, or -1 if row is invalid
+///
+int GroupedAppsModel::sectionOf(const int row) const
+{
+    if (row < 0 || row >= m_rowCount)
+        return -1;
+
+    const auto it = std::upper_bound(m_sections.cbegin(), m_sections.cend(), row, [] (const int r, const Section &section) {
+        return r < section.titleRow;
+    });
+
+    return it - m_sections.cbegin() - 1;
+}
+
+///
+/// \brief GroupedAppsModel::sectionOf find section of category
+/// \return section index, or -1 if category is empty
+///
+int GroupedAppsModel::sectionOf(const AppsListModel::AppCategory category) const
+{
+    return m_categorySections.value(category, -1);
+}
+
+AppsListModel::AppCategory GroupedAppsModel::sectionCategory(const int section) const
+{
+    return m_sources[m_sections[section].source]->category();
+}
+
+int GroupedAppsModel::sectionTitleRow(const int section) const
+{
+    return m_sections[section].titleRow;
+}
+
+int GroupedAppsModel::sectionSize(const int section) const
+{
+    return m_sections[section].size;
+}
+
+bool GroupedAppsModel::isSectionTitle(const QModelIndex &index) const
+{
+    const int section = sectionOf(index.row());
+
+    return section != -1 && m_sections[section].titleRow == index.row();
+}
+
+///
+/// \brief GroupedAppsModel::appIndex get index of app
+/// \param section section index
+/// \param pos position of app in this section
+///
+const QModelIndex GroupedAppsModel::appIndex(const int section, const int pos) const
+{
+    if (section < 0 || section >= m_sections.size() || pos < 0 || pos >= m_sections[section].size)
+        return QModelIndex();
+
+    return index(m_sections[section].titleRow + 1 + pos);
+}
+
+int GroupedAppsModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent)
+
+    return m_rowCount;
+}
+
+///
+/// \brief GroupedAppsModel::categoryName untranslated name of category, same as the daemon used
+///
+const QString GroupedAppsModel::categoryName(const AppsListModel::AppCategory category)
+{
+    switch (category)
+    {
+    case AppsListModel::Internet:       return "Internet";
+    case AppsListModel::Chat:           return "Chat";
+    case AppsListModel::Music:          return "Music";
+    case AppsListModel::Video:          return "Video";
+    case AppsListModel::Graphics:       return "Graphics";
+    case AppsListModel::Game:           return "Game";
+    case AppsListModel::Office:         return "Office";
+    case AppsListModel::Reading:        return "Reading";
+    case AppsListModel::Development:    return "Development";
+    case AppsListModel::System:         return "System";
+    case AppsListModel::Others:         return "Others";
+    default:;
+    }
+
+    return QString();
+}
+
+QVariant GroupedAppsModel::data(const QModelIndex &index, int role) const
+{
+    const int section = sectionOf(index.row());
+    if (!index.isValid() || section == -1)
+        return QVariant();
+
+    if (m_sections[section].titleRow != index.row())
+        return sourceIndex(index).data(role);
+
+    const AppsListModel::AppCategory category = sectionCategory(section);
+    switch (role)
+    {
+    case AppsListModel::AppNameRole:
+        return getCategoryNames(categoryName(category));
+    case AppsListModel::AppGroupRole:
+        return QVariant::fromValue(category);
+    default:;
+    }
+
+    return QVariant();
+}
+
+Qt::ItemFlags GroupedAppsModel::flags(const QModelIndex &index) const
+{
+    if (isSectionTitle(index))
+        return Qt::ItemIsEnabled;
+
+    return sourceIndex(index).flags();
+}
+
+QMimeData *GroupedAppsModel::mimeData(const QModelIndexList &indexes) const
+{
+    // only allow drag 1 item
+    Q_ASSERT(indexes.size() == 1);
+
+    const QModelIndex index = sourceIndex(indexes.first());
+    if (!index.isValid())
+        return nullptr;
+
+    return index.model()->mimeData(QModelIndexList() << index);
+}
+
+int GroupedAppsModel::sourceOf(const AppsListModel::AppCategory category) const
+{
+    for (int i(0); i != m_sources.size(); ++i)
+        if (m_sources[i]->category() == category)
+            return i;
+
+    return -1;
+}
+
+const QModelIndex GroupedAppsModel::sourceIndex(const QModelIndex &index) const
+{
+    const int section = sectionOf(index.row());
+    if (section == -1)
+        return QModelIndex();
+
+    const Section &s = m_sections[section];
+    if (index.row() == s.titleRow)
+        return QModelIndex();
+
+    return m_sources[s.source]->index(index.row() - s.titleRow - 1);
+}
+
+///
+/// \brief GroupedAppsModel::rebuildSections read category sizes from appsManager and rebuild row mapping
+///
+void GroupedAppsModel::rebuildSections()
+{
+    m_sections.clear();
+    m_categorySections.fill(-1, AppsListModel::Others + 1);
+    m_rowCount = 0;
+
+    for (int i(0); i != m_sources.size(); ++i)
+    {
+        const int size = m_appsManager->appsInfoList(m_sources[i]->category()).size();
+        if (!size)
+            continue;
+
+        m_categorySections[m_sources[i]->category()] = m_sections.size();
+        m_sections.append(Section {i, m_rowCount, size});
+        m_rowCount += size + 1;
+    }
+}
+
+void GroupedAppsModel::sourceDataChanged(const int source, const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+    const int section = sectionOf(m_sources[source]->category());
+    if (section == -1)
+        return;
+
+    const Section &s = m_sections[section];
+    const int first = qMax(0, topLeft.row());
+    // source model may report rows out of range when all rows are changed
+    const int last = bottomRight.isValid() ? qMin(bottomRight.row(), s.size - 1) : s.size - 1;
+    if (first > last)
+        return;
+
+    emit QAbstractItemModel::dataChanged(index(s.titleRow + 1 + first), index(s.titleRow + 1 + last), roles);
+}
+
+///
+/// \brief GroupedAppsModel::dataChanged apps may be stashed or restored without row notifications, reset if sizes are changed
+///
+void GroupedAppsModel::dataChanged(const AppsListModel::AppCategory category)
+{
+    if (category != AppsListModel::All && sourceOf(category) == -1)
+        return;
+
+    for (int i(0), section(0); i != m_sources.size(); ++i)
+    {
+        const int size = m_appsManager->appsInfoList(m_sources[i]->category()).size();
+        const bool hasSection = section < m_sections.size() && m_sections[section].source == i;
+        if (size != (hasSection ? m_sections[section].size : 0))
+            return layoutChanged(category);
+
+        if (hasSection)
+            ++section;
+    }
+}
+
+void GroupedAppsModel::layoutChanged(const AppsListModel::AppCategory category)
+{
+    if (category != AppsListModel::All && sourceOf(category) == -1)
+        return;
+
+    beginResetModel();
+    rebuildSections();
+    endResetModel();
+}
+
+void GroupedAppsModel::itemAboutToBeInserted(const AppsListModel::AppCategory category, const int row)
+{
+    const int source = sourceOf(category);
+    if (source == -1)
+        return;
+
+    const int section = sectionOf(category);
+    if (section != -1)
+    {
+        const int r = m_sections[section].titleRow + 1 + row;
+        return beginInsertRows(QModelIndex(), r, r);
+    }
+
+    // first app of this category, insert title row too
+    int titleRow = m_rowCount;
+    for (const Section &s : m_sections)
+    {
+        if (s.source < source)
+            continue;
+
+        titleRow = s.titleRow;
+        break;
+    }
+
+    beginInsertRows(QModelIndex(), titleRow, titleRow + 1);
+}
+
+void GroupedAppsModel::itemInserted(const AppsListModel::AppCategory category)
+{
+    if (sourceOf(category) == -1)
+        return;
+
+    rebuildSections();
+    endInsertRows();
+}
+
+void GroupedAppsModel::itemAboutToBeRemoved(const AppsListModel::AppCategory category, const int row)
+{
+    const int section = sectionOf(category);
+    if (section == -1)
+        return;
+
+    const Section &s = m_sections[section];
+
+    // last app of this category, remove title row too
+    if (s.size == 1)
+        beginRemoveRows(QModelIndex(), s.titleRow, s.titleRow + 1);
+    else
+        beginRemoveRows(QModelIndex(), s.titleRow + 1 + row, s.titleRow + 1 + row);
+}
+
+void GroupedAppsModel::itemRemoved(const AppsListModel::AppCategory category)
+{
+    if (sourceOf(category) == -1)
+        return;
+
+    rebuildSections();
+    endRemoveRows();
+}
@@ -0,0 +1,76 @@
+#ifndef GROUPEDAPPSMODEL_H
+#define GROUPEDAPPSMODEL_H
+
+#include "appslistmodel.h"
+
+#include <QAbstractListModel>
+#include <QList>
+#include <QVector>
+
+class AppsManager;
+
+///
+/// \brief The GroupedAppsModel class flattens all category lists into one list
+///
+/// every non-empty category is a section, the first row of a section is its
+/// title, followed by apps of this category. app rows are forwarded to the
+/// per-category AppsListModel, so item data and role cache are shared with
+/// other views.
+///
+class GroupedAppsModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    explicit GroupedAppsModel(QObject *parent = 0);
+
+    inline int sectionCount() const {return m_sections.size();}
+    int sectionOf(const int row) const;
+    int sectionOf(const AppsListModel::AppCategory category) const;
+    AppsListModel::AppCategory sectionCategory(const int section) const;
+    int sectionTitleRow(const int section) const;
+    int sectionSize(const int section) const;
+    bool isSectionTitle(const QModelIndex &index) const;
+    const QModelIndex appIndex(const int section, const int pos) const;
+
+    int rowCount(const QModelIndex &parent) const Q_DECL_OVERRIDE;
+
+    static const QString categoryName(const AppsListModel::AppCategory category);
+
+protected:
+    QVariant data(const QModelIndex &index, int role) const Q_DECL_OVERRIDE;
+    Qt::ItemFlags flags(const QModelIndex &index) const Q_DECL_OVERRIDE;
+    QMimeData *mimeData(const QModelIndexList &indexes) const Q_DECL_OVERRIDE;
+
+private:
+    int sourceOf(const AppsListModel::AppCategory category) const;
+    const QModelIndex sourceIndex(const QModelIndex &index) const;
+    void rebuildSections();
+    void sourceDataChanged(const int source, const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+    void dataChanged(const AppsListModel::AppCategory category);
+    void layoutChanged(const AppsListModel::AppCategory category);
+    void itemAboutToBeInserted(const AppsListModel::AppCategory category, const int row);
+    void itemInserted(const AppsListModel::AppCategory category);
+    void itemAboutToBeRemoved(const AppsListModel::AppCategory category, const int row);
+    void itemRemoved(const AppsListModel::AppCategory category);
+
+private:
+    struct Section {
+        // index of m_sources
+        int source;
+        int titleRow;
+        int size;
+    };
+
+    AppsManager *m_appsManager;
+
+    // category models in display order
+    QList<AppsListModel *> m_sources;
+    // non-empty categories only
+    QVector<Section> m_sections;
+    // category -> section index, -1 if category is empty
+    QVector<int> m_categorySections;
+    int m_rowCount = 0;
+};
+
+#endif // GROUPEDAPPSMODEL_H
@@ -0,0 +1,308 @@
+#include "iconatlas.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QVector>
+
+static const quint32 AtlasMagic = 0x41494c44; // "DLIA"
+static const quint32 AtlasFormatVersion = 2;
+static const quint32 AtlasIndexAlignment = 4;
+static const quint32 AtlasDataAlignment = 16;
+
+static inline quint32 alignTo(const quint32 offset, const quint32 alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+IconAtlas::IconAtlas(const QString &fileName, const QString &version) :
+    m_fileName(fileName),
+    m_version(version),
+    m_file(fileName)
+{
+    load();
+}
+
+IconAtlas::~IconAtlas()
+{
+    unload();
+}
+
+///
+/// \brief IconAtlas::image find icon in atlas
+/// \param iconKey icon key of app item
+/// \param size icon size
+/// \return a QImage which shares memory with the mapped atlas, or null image if not found.
+/// the image is valid until save(), copy it before keeping it longer
+///
+const QImage IconAtlas::image(const QString &iconKey, const int size) const
+{
+    const QString key = entryKey(iconKey, size);
+
+    const auto pending = m_pending.constFind(key);
+    if (pending != m_pending.constEnd())
+        return pending.value();
+
+    const auto it = m_index.constFind(key);
+    if (it == m_index.constEnd())
+        return QImage();
+
+    const Entry &entry = it.value();
+    return QImage(m_mapped + entry.dataOffset, entry.size, entry.size, entry.size * 4, QImage::Format_ARGB32_Premultiplied);
+}
+
+///
+/// \brief IconAtlas::dataOffset find offset of icon pixels in atlas file, for other processes map the same file
+/// \return -1 if icon is not saved in atlas file
+///
+qint64 IconAtlas::dataOffset(const QString &iconKey, const int size) const
+{
+    const auto it = m_index.constFind(entryKey(iconKey, size));
+    if (it == m_index.constEnd() || m_pending.contains(it.key()))
+        return -1;
+
+    return it.value().dataOffset;
+}
+
+void IconAtlas::insert(const QString &iconKey, const int size, const QImage &image)
+{
+    if (image.isNull())
+        return;
+
+    QImage img = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    if (img.width() != size || img.height() != size)
+        img = img.scaled(size, size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+    m_pending.insert(entryKey(iconKey, size), img);
+    m_dirty = true;
+}
+
+///
+/// \brief IconAtlas::remove remove all sizes of icon from atlas
+/// \param iconKey icon key of app item
+///
+void IconAtlas::remove(const QString &iconKey)
+{
+    const QString prefix = iconKey + '-';
+    auto matched = [&prefix] (const QString &key) {
+        return key.startsWith(prefix) && key.lastIndexOf('-') == prefix.size() - 1;
+    };
+
+    for (auto it(m_index.begin()); it != m_index.end();)
+    {
+        if (matched(it.key()))
+        {
+            it = m_index.erase(it);
+            m_dirty = true;
+        } else {
+            ++it;
+        }
+    }
+
+    for (auto it(m_pending.begin()); it != m_pending.end();)
+    {
+        if (matched(it.key()))
+        {
+            it = m_pending.erase(it);
+            m_dirty = true;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void IconAtlas::clear()
+{
+    m_index.clear();
+    m_pending.clear();
+    m_dirty = true;
+}
+
+///
+/// \brief IconAtlas::save rewrite atlas file with mapped and pending icons, then map it again
+/// \return true if atlas is written to disk
+///
+bool IconAtlas::save()
+{
+    if (!m_dirty)
+        return true;
+
+    // collect all icons, mapped images are still valid until unload()
+    QList<QString> keys;
+    QList<QImage> images;
+    for (auto it(m_index.constBegin()); it != m_index.constEnd(); ++it)
+    {
+        keys.append(it.key());
+        images.append(image(it.key().left(it.key().lastIndexOf('-')), it.value().size));
+    }
+    for (auto it(m_pending.constBegin()); it != m_pending.constEnd(); ++it)
+    {
+        keys.append(it.key());
+        images.append(it.value());
+    }
+
+    const QByteArray version = m_version.toUtf8();
+    QByteArray keysData;
+    QVector<Entry> entries;
+    entries.reserve(keys.size());
+
+    Header header;
+    header.magic = AtlasMagic;
+    header.formatVersion = AtlasFormatVersion;
+    header.versionLength = version.size();
+    header.count = keys.size();
+    // index records are read in place, keep them aligned
+    header.indexOffset = alignTo(sizeof(Header) + version.size(), AtlasIndexAlignment);
+    header.keysOffset = header.indexOffset + sizeof(Entry) * keys.size();
+
+    for (int i(0); i != keys.size(); ++i)
+    {
+        const QByteArray key = keys[i].toUtf8();
+
+        Entry entry;
+        entry.keyOffset = keysData.size();
+        entry.keyLength = key.size();
+        entry.size = images[i].width();
+        entry.dataOffset = 0;
+
+        keysData.append(key);
+        entries.append(entry);
+    }
+
+    header.dataOffset = alignTo(header.keysOffset + keysData.size(), AtlasDataAlignment);
+
+    quint32 offset = header.dataOffset;
+    for (Entry &entry : entries)
+    {
+        entry.dataOffset = offset;
+        offset = alignTo(offset + entry.size * entry.size * 4, AtlasDataAlignment);
+    }
+    header.fileSize = offset;
+
+    QDir().mkpath(QFileInfo(m_fileName).absolutePath());
+
+    QSaveFile file(m_fileName);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qWarning() << "open icon atlas failed" << m_fileName << file.errorString();
+        return false;
+    }
+
+    const QByteArray padding(AtlasDataAlignment, '\0');
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    file.write(version);
+    file.write(padding.constData(), header.indexOffset - sizeof(Header) - version.size());
+    file.write(reinterpret_cast<const char *>(entries.constData()), sizeof(Entry) * entries.size());
+    file.write(keysData);
+
+    qint64 written = header.keysOffset + keysData.size();
+    for (int i(0); i != entries.size(); ++i)
+    {
+        file.write(padding.constData(), entries[i].dataOffset - written);
+
+        const QImage &img = images[i];
+        for (int line(0); line != img.height(); ++line)
+            file.write(reinterpret_cast<const char *>(img.constScanLine(line)), img.width() * 4);
+
+        written = entries[i].dataOffset + entries[i].size * entries[i].size * 4;
+    }
+    file.write(padding.constData(), header.fileSize - written);
+
+    // images may point to mapped memory, release them before unmap
+    images.clear();
+    unload();
+
+    if (!file.commit())
+    {
+        qWarning() << "write icon atlas failed" << m_fileName << file.errorString();
+        load();
+        return false;
+    }
+
+    m_pending.clear();
+    load();
+
+    return true;
+}
+
+void IconAtlas::load()
+{
+    unload();
+
+    if (!m_file.open(QIODevice::ReadOnly))
+        return;
+
+    const qint64 fileSize = m_file.size();
+    const uchar *mapped = fileSize >= qint64(sizeof(Header)) ? m_file.map(0, fileSize) : nullptr;
+
+    do {
+        if (!mapped)
+            break;
+
+        // file may be truncated or corrupted, check every offset against file size in 64 bits
+        const Header *header = reinterpret_cast<const Header *>(mapped);
+        if (header->magic != AtlasMagic || header->formatVersion != AtlasFormatVersion || header->fileSize != fileSize)
+            break;
+        if (header->indexOffset % AtlasIndexAlignment || sizeof(Header) + quint64(header->versionLength) > header->indexOffset)
+            break;
+        if (header->keysOffset != header->indexOffset + quint64(sizeof(Entry)) * header->count)
+            break;
+        if (header->keysOffset > header->dataOffset || header->dataOffset > quint64(fileSize))
+            break;
+
+        // outdated atlas, icons may be changed.
+        const QString version = QString::fromUtf8(reinterpret_cast<const char *>(mapped + sizeof(Header)), header->versionLength);
+        if (version != m_version)
+            break;
+
+        const Entry *entries = reinterpret_cast<const Entry *>(mapped + header->indexOffset);
+        const char *keys = reinterpret_cast<const char *>(mapped + header->keysOffset);
+        const quint64 keysSize = header->dataOffset - header->keysOffset;
+
+        bool valid = true;
+        m_index.reserve(header->count);
+        for (quint32 i(0); valid && i != header->count; ++i)
+        {
+            const Entry &entry = entries[i];
+            valid = quint64(entry.keyOffset) + entry.keyLength <= keysSize &&
+                    entry.dataOffset >= header->dataOffset && entry.dataOffset % AtlasDataAlignment == 0 &&
+                    entry.dataOffset + quint64(entry.size) * entry.size * 4 <= quint64(fileSize);
+
+            if (valid)
+                m_index.insert(QString::fromUtf8(keys + entry.keyOffset, entry.keyLength), entry);
+        }
+
+        if (!valid)
+        {
+            m_index.clear();
+            break;
+        }
+
+        m_mapped = mapped;
+        m_mappedSize = fileSize;
+        m_dirty = false;
+
+        return;
+    } while (false);
+
+    // invalid atlas file, drop it on next save.
+    if (mapped)
+        m_file.unmap(const_cast<uchar *>(mapped));
+    m_file.close();
+    m_dirty = true;
+}
+
+void IconAtlas::unload()
+{
+    m_index.clear();
+
+    if (m_mapped)
+        m_file.unmap(const_cast<uchar *>(m_mapped));
+    m_mapped = nullptr;
+    m_mappedSize = 0;
+
+    if (m_file.isOpen())
+        m_file.close();
+}
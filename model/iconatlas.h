@@ -0,0 +1,76 @@
+#ifndef ICONATLAS_H
+#define ICONATLAS_H
+
+#include <QFile>
+#include <QHash>
+#include <QImage>
+#include <QString>
+
+///
+/// \brief The IconAtlas class is a memory-mapped binary cache of rendered app icons
+///
+/// layout of the atlas file:
+///   Header                        fixed size, see IconAtlas::Header
+///   char   version[versionLength] application version the atlas was built with
+///   Entry  index[count]           one record per (icon key, size), 4 bytes aligned
+///   char   keys[]                 utf-8 icon keys, referenced by index records
+///   pixels                        premultiplied ARGB32 pages, 16 bytes aligned
+///
+/// lookups wrap the mapped pixels in a QImage without copying them, new icons are
+/// kept in memory until save() rewrites the whole atlas. save() remaps the file,
+/// images returned before it must not be used after it. a file with any offset
+/// out of range is dropped on load.
+///
+class IconAtlas
+{
+public:
+    explicit IconAtlas(const QString &fileName, const QString &version);
+    ~IconAtlas();
+
+    const QImage image(const QString &iconKey, const int size) const;
+    qint64 dataOffset(const QString &iconKey, const int size) const;
+    inline const QString &fileName() const {return m_fileName;}
+    void insert(const QString &iconKey, const int size, const QImage &image);
+    void remove(const QString &iconKey);
+    void clear();
+    bool isDirty() const { return m_dirty; }
+    bool save();
+
+private:
+    struct Header {
+        quint32 magic;
+        quint32 formatVersion;
+        quint32 versionLength;
+        quint32 count;
+        quint32 indexOffset;
+        quint32 keysOffset;
+        quint32 dataOffset;
+        quint32 fileSize;
+    };
+
+    struct Entry {
+        quint32 keyOffset;
+        quint32 keyLength;
+        quint32 size;
+        quint32 dataOffset;
+    };
+
+    static inline const QString entryKey(const QString &iconKey, const int size) {return QString("%1-%2").arg(iconKey).arg(size);}
+
+    void load();
+    void unload();
+
+private:
+    const QString m_fileName;
+    const QString m_version;
+
+    bool m_dirty = false;
+    QFile m_file;
+    const uchar *m_mapped = nullptr;
+    qint64 m_mappedSize = 0;
+
+    QHash<QString, Entry> m_index;
+    QHash<QString, QImage> m_pending;
+};
+
+#endif // ICONATLAS_H
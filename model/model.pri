@@ -0,0 +1,23 @@
+INCLUDEPATH += $$PWD
+
+HEADERS += \
+    $$PWD/appslistmodel.h \
+    $$PWD/appsmanager.h \
+    $$PWD/appscatalog.h \
+    $$PWD/groupedappsmodel.h \
+    $$PWD/appssearchindex.h \
+    $$PWD/autostartindex.h \
+    $$PWD/appsorder.h \
+    $$PWD/iconatlas.h \
+    $$PWD/sharedcatalog.h
+
+SOURCES += \
+    $$PWD/appslistmodel.cpp \
+    $$PWD/appsmanager.cpp \
+    $$PWD/appscatalog.cpp \
+    $$PWD/groupedappsmodel.cpp \
+    $$PWD/appssearchindex.cpp \
+    $$PWD/autostartindex.cpp \
+    $$PWD/appsorder.cpp \
+    $$PWD/iconatlas.cpp \
+    $$PWD/sharedcatalog.cpp
@@ -0,0 +1,153 @@
+#include "sharedcatalog.h"
+
+#include <QHash>
+#include <QDateTime>
+#include <QDebug>
+
+#include <string.h>
+#include <unistd.h>
+
+static const quint32 CatalogMagic = 0x43414c44; // "DLAC"
+static const quint32 CatalogFormatVersion = 1;
+static const int CatalogMinimumSize = 64 * 1024;
+// keys tried before giving up creating a segment
+static const int CatalogMaxCreateAttempts = 8;
+
+SharedCatalog::SharedCatalog() :
+    // generations of different launcher instances never collide
+    m_generation(QDateTime::currentMSecsSinceEpoch() * 1000)
+{
+}
+
+SharedCatalog::~SharedCatalog()
+{
+    markObsolete();
+    m_memory.detach();
+}
+
+///
+/// \brief SharedCatalog::markObsolete tell readers the segment won't be updated anymore
+///
+void SharedCatalog::markObsolete()
+{
+    if (!m_memory.isAttached())
+        return;
+
+    m_memory.lock();
+    reinterpret_cast<Header *>(m_memory.data())->flags |= Obsolete;
+    m_memory.unlock();
+}
+
+///
+/// \brief SharedCatalog::publish write apps into shared memory
+/// \return true if catalog is changed and generation is increased
+///
+bool SharedCatalog::publish(const QVector<App> &apps, const QString &iconAtlas, const int iconSize)
+{
+    QByteArray strings;
+    QHash<QString, quint32> stringOffsets;
+    auto intern = [&] (const QString &str, quint32 *offset, quint32 *length) {
+        const QByteArray utf8 = str.toUtf8();
+        auto it = stringOffsets.constFind(str);
+        if (it == stringOffsets.cend())
+        {
+            it = stringOffsets.insert(str, strings.size());
+            strings.append(utf8);
+        }
+
+        *offset = it.value();
+        *length = utf8.size();
+    };
+
+    QVector<Entry> entries;
+    entries.reserve(apps.size());
+    for (const App &app : apps)
+    {
+        Entry entry;
+        intern(app.info->m_key, &entry.keyOffset, &entry.keyLength);
+        intern(app.info->m_name, &entry.nameOffset, &entry.nameLength);
+        intern(app.info->m_desktop, &entry.desktopOffset, &entry.desktopLength);
+        intern(app.info->m_iconKey, &entry.iconKeyOffset, &entry.iconKeyLength);
+        entry.category = app.info->category();
+        entry.flags = app.flags;
+        entry.iconDataOffset = app.iconDataOffset;
+        entry.installedTime = app.info->m_installedTime;
+
+        entries.append(entry);
+    }
+
+    Header header;
+    memset(&header, 0, sizeof(Header));
+    header.magic = CatalogMagic;
+    header.formatVersion = CatalogFormatVersion;
+    header.count = entries.size();
+    header.entriesOffset = sizeof(Header);
+    header.iconSize = iconSize;
+    intern(iconAtlas, &header.iconAtlasOffset, &header.iconAtlasLength);
+
+    const int entriesSize = sizeof(Entry) * entries.size();
+    header.stringsOffset = header.entriesOffset + entriesSize;
+    header.size = header.stringsOffset + strings.size();
+
+    QByteArray data;
+    data.reserve(header.size);
+    data.append(reinterpret_cast<const char *>(&header), sizeof(Header));
+    data.append(reinterpret_cast<const char *>(entries.constData()), entriesSize);
+    data.append(strings);
+
+    if (data == m_data && m_memory.isAttached())
+        return false;
+
+    if (!reserve(data.size()))
+        return false;
+
+    m_data = data;
+    ++m_generation;
+
+    Header *shared = reinterpret_cast<Header *>(m_memory.data());
+    m_memory.lock();
+    memcpy(m_memory.data(), data.constData(), data.size());
+    shared->generation = m_generation;
+    m_memory.unlock();
+
+    return true;
+}
+
+///
+/// \brief SharedCatalog::reserve make sure segment can hold size bytes, create a new one if needed
+///
+bool SharedCatalog::reserve(const int size)
+{
+    if (m_memory.isAttached() && m_memory.size() >= size)
+        return true;
+
+    // readers of old segment will see it's obsolete, and attach the new one
+    if (m_memory.isAttached())
+    {
+        markObsolete();
+        m_memory.detach();
+    }
+
+    const int capacity = qMax(CatalogMinimumSize, size * 2);
+    for (int i(0); i != CatalogMaxCreateAttempts && !m_memory.isAttached(); ++i)
+    {
+        // pid is in key, segments of other launcher instances are never reused
+        m_memory.setKey(QString("dde-launcher-catalog-%1-%2-%3").arg(getuid()).arg(getpid()).arg(m_segment++));
+        if (m_memory.create(capacity) || m_memory.error() != QSharedMemory::AlreadyExists)
+            continue;
+
+        // segment is left by a crashed launcher with the same pid, release it if nobody
+        // uses it, otherwise try next key
+        if (m_memory.attach())
+            m_memory.detach();
+        m_memory.create(capacity);
+    }
+
+    if (!m_memory.isAttached())
+    {
+        qWarning() << "create shared catalog failed" << m_memory.errorString();
+        return false;
+    }
+
+    return true;
+}
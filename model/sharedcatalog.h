@@ -0,0 +1,99 @@
+#ifndef SHAREDCATALOG_H
+#define SHAREDCATALOG_H
+
+#include "dbusinterface/dbusvariant/iteminfo.h"
+
+#include <QSharedMemory>
+#include <QByteArray>
+#include <QVector>
+
+///
+/// \brief The SharedCatalog class publishes apps into a shared memory segment, other local processes read it without D-Bus
+///
+/// layout of the segment, numbers are in native byte order:
+///   Header                    fixed size, see SharedCatalog::Header
+///   Entry  entries[count]     one record per app, in user sorted order
+///   char   strings[]          interned utf-8 strings, not terminated, referenced by (offset, length)
+///
+/// readers attach the segment read only, and hold QSharedMemory::lock() while
+/// reading it. generation is increased every time the catalog is changed, it
+/// starts from the launcher start time, so (key, generation) is never reused by
+/// another launcher instance. when the catalog outgrows the segment, a new
+/// segment with another key is created and the old one is marked Obsolete, so
+/// is the segment of a quitting launcher. the current key and generation are
+/// announced by CatalogChanged signal of launcher D-Bus service.
+///
+class SharedCatalog
+{
+public:
+    enum HeaderFlag {
+        Obsolete = 1 << 0,
+    };
+
+    enum AppFlag {
+        AutoStart = 1 << 0,
+        OnDock = 1 << 1,
+        OnDesktop = 1 << 2,
+        NewInstall = 1 << 3,
+    };
+
+    struct Header {
+        quint32 magic;
+        quint32 formatVersion;
+        quint64 generation;
+        quint32 flags;
+        // bytes used in segment
+        quint32 size;
+        quint32 count;
+        quint32 entriesOffset;
+        quint32 stringsOffset;
+        // path of icon atlas file, entries refer to icon pixels in it
+        quint32 iconAtlasOffset;
+        quint32 iconAtlasLength;
+        // size of icons in atlas, icons are premultiplied ARGB32 in size * size
+        quint32 iconSize;
+    };
+
+    struct Entry {
+        quint32 keyOffset;
+        quint32 keyLength;
+        quint32 nameOffset;
+        quint32 nameLength;
+        quint32 desktopOffset;
+        quint32 desktopLength;
+        quint32 iconKeyOffset;
+        quint32 iconKeyLength;
+        quint32 category;
+        quint32 flags;
+        // offset of icon pixels in icon atlas file, -1 if icon is not in atlas
+        qint64 iconDataOffset;
+        qint64 installedTime;
+    };
+
+    struct App {
+        const ItemInfo *info;
+        quint32 flags;
+        qint64 iconDataOffset;
+    };
+
+    SharedCatalog();
+    ~SharedCatalog();
+
+    bool publish(const QVector<App> &apps, const QString &iconAtlas, const int iconSize);
+    inline const QString key() const {return m_memory.key();}
+    inline quint64 generation() const {return m_generation;}
+
+private:
+    bool reserve(const int size);
+    void markObsolete();
+
+private:
+    QSharedMemory m_memory;
+    // increased when a new segment is created
+    int m_segment = 0;
+    quint64 m_generation;
+    // published data without generation, to skip publishing same catalog
+    QByteArray m_data;
+};
+
+#endif // SHAREDCATALOG_H
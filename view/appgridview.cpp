@@ -0,0 +1,500 @@
+#include "appgridview.h"
+#include "global_util/constants.h"
+#include "global_util/calculate_util.h"
+#include "model/groupedappsmodel.h"
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QDrag>
+#include <QMimeData>
+#include <QPropertyAnimation>
+
+#include <algorithm>
+
+// same as the layout margin and spacing of CategoryTitleWidget
+static const int TitleMargin = 11;
+static const int TitleSpacing = 6;
+
+AppGridView::AppGridView(QWidget *parent) :
+    QAbstractItemView(parent),
+    m_calcUtil(CalculateUtil::instance(this)),
+    m_opacityAnimation(new QPropertyAnimation(this, "titleOpacity", this))
+{
+    m_opacityAnimation->setDuration(300);
+
+    setMouseTracking(true);
+    setFocusPolicy(Qt::NoFocus);
+    setSelectionMode(QAbstractItemView::NoSelection);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setFrameStyle(QFrame::NoFrame);
+
+    setStyleSheet("background-color:transparent;");
+
+    // item size and spacing are changed
+    connect(m_calcUtil, &CalculateUtil::layoutChanged, this, &AppGridView::relayout);
+}
+
+void AppGridView::setModel(QAbstractItemModel *model)
+{
+    // base class will reconnect its own slots
+    if (m_groupedModel)
+        m_groupedModel->disconnect(this);
+
+    m_groupedModel = qobject_cast<GroupedAppsModel *>(model);
+    Q_ASSERT(m_groupedModel || !model);
+
+    QAbstractItemView::setModel(model);
+
+    if (m_groupedModel)
+    {
+        connect(m_groupedModel, &GroupedAppsModel::rowsInserted, this, &AppGridView::relayout);
+        connect(m_groupedModel, &GroupedAppsModel::rowsRemoved, this, &AppGridView::relayout);
+        connect(m_groupedModel, &GroupedAppsModel::modelReset, this, &AppGridView::relayout);
+        connect(m_groupedModel, &GroupedAppsModel::layoutChanged, this, &AppGridView::relayout);
+    }
+
+    relayout();
+}
+
+QRect AppGridView::visualRect(const QModelIndex &index) const
+{
+    if (!m_groupedModel || index.model() != m_groupedModel)
+        return QRect();
+
+    const int section = m_groupedModel->sectionOf(index.row());
+    if (section == -1 || section >= m_sectionTops.size())
+        return QRect();
+
+    const int pos = index.row() - m_groupedModel->sectionTitleRow(section) - 1;
+    if (pos == -1)
+        return sectionTitleRect(section);
+
+    return itemRect(section, pos);
+}
+
+///
+/// \brief AppGridView::scrollTo this view is always fit to content, it's scrolled by the container
+///
+void AppGridView::scrollTo(const QModelIndex &index, ScrollHint hint)
+{
+    Q_UNUSED(index)
+    Q_UNUSED(hint)
+}
+
+///
+/// \brief AppGridView::indexAt find app item at point, titles and spacing between items are not items
+///
+QModelIndex AppGridView::indexAt(const QPoint &point) const
+{
+    const int section = sectionAt(point.y());
+    if (section == -1 || point.x() < 0)
+        return QModelIndex();
+
+    const QRect itemsRect = sectionItemsRect(section);
+    if (!itemsRect.contains(point))
+        return QModelIndex();
+
+    const QSize itemSize = m_calcUtil->appItemSize();
+    const int spacing = m_calcUtil->appItemSpacing();
+    const int column = point.x() / (itemSize.width() + spacing * 2);
+    const int row = (point.y() - itemsRect.top()) / (itemSize.height() + spacing * 2);
+    if (column >= m_calcUtil->appColumnCount())
+        return QModelIndex();
+
+    const int pos = row * m_calcUtil->appColumnCount() + column;
+    if (pos >= m_groupedModel->sectionSize(section) || !itemRect(section, pos).contains(point))
+        return QModelIndex();
+
+    return m_groupedModel->appIndex(section, pos);
+}
+
+///
+/// \brief AppGridView::moveIndex find next app for keyboard navigation, column is kept when move across categories
+/// \param index current app index
+/// \param action move direction
+/// \return next app index, or invalid index if can't move
+///
+const QModelIndex AppGridView::moveIndex(const QModelIndex &index, const CursorAction action) const
+{
+    if (!m_groupedModel || index.model() != m_groupedModel)
+        return QModelIndex();
+
+    const int section = m_groupedModel->sectionOf(index.row());
+    if (section == -1)
+        return QModelIndex();
+
+    const int pos = index.row() - m_groupedModel->sectionTitleRow(section) - 1;
+    if (pos == -1)
+        return m_groupedModel->appIndex(section, 0);
+
+    const int column = m_calcUtil->appColumnCount();
+    const int realColumn = pos % column;
+    const int size = m_groupedModel->sectionSize(section);
+
+    switch (action)
+    {
+    case MoveLeft:
+    case MovePrevious:
+        if (pos)
+            return m_groupedModel->appIndex(section, pos - 1);
+        if (section)
+            return m_groupedModel->appIndex(section - 1, m_groupedModel->sectionSize(section - 1) - 1);
+        break;
+    case MoveRight:
+    case MoveNext:
+        if (pos + 1 < size)
+            return m_groupedModel->appIndex(section, pos + 1);
+        return m_groupedModel->appIndex(section + 1, 0);
+    case MoveUp:
+        if (pos >= column)
+            return m_groupedModel->appIndex(section, pos - column);
+        for (int s(section - 1); s >= 0; --s)
+        {
+            const int prevSize = m_groupedModel->sectionSize(s);
+            if (prevSize <= realColumn)
+                continue;
+
+            const int last = (prevSize - 1) / column * column + realColumn;
+            return m_groupedModel->appIndex(s, last < prevSize ? last : last - column);
+        }
+        break;
+    case MoveDown:
+        if (pos + column < size)
+            return m_groupedModel->appIndex(section, pos + column);
+        for (int s(section + 1); s < m_groupedModel->sectionCount(); ++s)
+            if (m_groupedModel->sectionSize(s) > realColumn)
+                return m_groupedModel->appIndex(s, realColumn);
+        break;
+    default:;
+    }
+
+    return QModelIndex();
+}
+
+///
+/// \brief AppGridView::indexYOffset return item Y offset of current view
+/// \param index item index
+/// \return pixel of Y offset
+///
+int AppGridView::indexYOffset(const QModelIndex &index) const
+{
+    return visualRect(index).y();
+}
+
+///
+/// \brief AppGridView::categoryAt find category at y offset, title belongs to the category below it
+/// \param y y offset of this view, clamped to view area
+/// \return AppsListModel::All if there is no category
+///
+AppsListModel::AppCategory AppGridView::categoryAt(const int y) const
+{
+    if (m_sectionTops.isEmpty())
+        return AppsListModel::All;
+
+    const int section = sectionAt(qBound(0, y, height() - 1));
+    Q_ASSERT(section != -1);
+
+    return m_groupedModel->sectionCategory(section);
+}
+
+const QRect AppGridView::titleRect(const AppsListModel::AppCategory category) const
+{
+    const int section = m_groupedModel ? m_groupedModel->sectionOf(category) : -1;
+    if (section == -1 || section >= m_sectionTops.size())
+        return QRect();
+
+    return sectionTitleRect(section);
+}
+
+///
+/// \brief AppGridView::categoryRect area of apps in category, title is not included
+///
+const QRect AppGridView::categoryRect(const AppsListModel::AppCategory category) const
+{
+    const int section = m_groupedModel ? m_groupedModel->sectionOf(category) : -1;
+    if (section == -1 || section >= m_sectionTops.size())
+        return QRect();
+
+    return sectionItemsRect(section);
+}
+
+qreal AppGridView::titleOpacity() const
+{
+    return m_titleOpacity;
+}
+
+void AppGridView::setTitleOpacity(const qreal titleOpacity)
+{
+    if (m_titleOpacity == titleOpacity)
+        return;
+
+    m_titleOpacity = titleOpacity;
+
+    for (int i(0); i != m_sectionTops.size(); ++i)
+        viewport()->update(sectionTitleRect(i));
+}
+
+void AppGridView::setTitleVisible(const bool visible, const bool animation)
+{
+    m_opacityAnimation->stop();
+
+    if (!animation)
+        return setTitleOpacity(visible ? 1 : 0);
+
+    m_opacityAnimation->setStartValue(titleOpacity());
+    m_opacityAnimation->setEndValue(visible ? 1 : 0);
+    m_opacityAnimation->start();
+}
+
+QModelIndex AppGridView::moveCursor(CursorAction cursorAction, Qt::KeyboardModifiers modifiers)
+{
+    Q_UNUSED(modifiers)
+
+    return moveIndex(currentIndex(), cursorAction);
+}
+
+int AppGridView::horizontalOffset() const
+{
+    return 0;
+}
+
+int AppGridView::verticalOffset() const
+{
+    return 0;
+}
+
+bool AppGridView::isIndexHidden(const QModelIndex &index) const
+{
+    Q_UNUSED(index)
+
+    return false;
+}
+
+void AppGridView::setSelection(const QRect &rect, QItemSelectionModel::SelectionFlags command)
+{
+    Q_UNUSED(rect)
+    Q_UNUSED(command)
+}
+
+QRegion AppGridView::visualRegionForSelection(const QItemSelection &selection) const
+{
+    Q_UNUSED(selection)
+
+    return QRegion();
+}
+
+void AppGridView::paintEvent(QPaintEvent *e)
+{
+    if (!m_groupedModel || m_sectionTops.isEmpty())
+        return;
+
+    const QRect exposed = e->rect();
+    const int column = m_calcUtil->appColumnCount();
+    const int rowHeight = m_calcUtil->appItemSize().height() + m_calcUtil->appItemSpacing() * 2;
+
+    QPainter painter(viewport());
+    QStyleOptionViewItem option = viewOptions();
+
+    for (int section(qMax(0, sectionAt(exposed.top()))); section < m_sectionTops.size(); ++section)
+    {
+        if (m_sectionTops[section] > exposed.bottom())
+            break;
+
+        const QRect title = sectionTitleRect(section);
+        if (title.intersects(exposed))
+        {
+            const QModelIndex titleIndex = m_groupedModel->index(m_groupedModel->sectionTitleRow(section));
+            paintTitle(&painter, title, titleIndex.data(AppsListModel::AppNameRole).toString());
+        }
+
+        // only rows intersect exposed rect
+        const QRect items = sectionItemsRect(section);
+        const QRect dirty = items.intersected(exposed);
+        if (dirty.isEmpty())
+            continue;
+
+        const int size = m_groupedModel->sectionSize(section);
+        const int firstRow = (dirty.top() - items.top()) / rowHeight;
+        const int lastRow = (dirty.bottom() - items.top()) / rowHeight;
+        for (int row(firstRow); row <= lastRow; ++row)
+        {
+            for (int i(0); i != column; ++i)
+            {
+                const int pos = row * column + i;
+                if (pos >= size)
+                    break;
+
+                option.rect = itemRect(section, pos);
+                if (option.rect.intersects(exposed))
+                    itemDelegate()->paint(&painter, option, m_groupedModel->appIndex(section, pos));
+            }
+        }
+    }
+}
+
+void AppGridView::mousePressEvent(QMouseEvent *e)
+{
+    if (e->buttons() == Qt::RightButton) {
+        QPoint rightClickPoint = mapToGlobal(e->pos());
+
+        const QModelIndex &clickedIndex = indexAt(e->pos());
+        if (clickedIndex.isValid())
+            emit popupMenuRequested(rightClickPoint, clickedIndex);
+    }
+
+    if (e->buttons() == Qt::LeftButton)
+        m_dragStartPos = e->pos();
+
+    QAbstractItemView::mousePressEvent(e);
+}
+
+void AppGridView::mouseMoveEvent(QMouseEvent *e)
+{
+    QAbstractItemView::mouseMoveEvent(e);
+
+    if (e->buttons() != Qt::LeftButton)
+        return;
+
+    if (qAbs(e->pos().x() - m_dragStartPos.x()) > DLauncher::DRAG_THRESHOLD ||
+        qAbs(e->pos().y() - m_dragStartPos.y()) > DLauncher::DRAG_THRESHOLD)
+        dragApp(indexAt(m_dragStartPos));
+}
+
+void AppGridView::mouseReleaseEvent(QMouseEvent *e)
+{
+    // request main frame hide when click invalid area
+    if (e->button() != Qt::LeftButton)
+        return;
+
+    const QModelIndex index = indexAt(e->pos());
+    if (!index.isValid())
+        emit clicked(index);
+
+    QAbstractItemView::mouseReleaseEvent(e);
+}
+
+void AppGridView::wheelEvent(QWheelEvent *e)
+{
+    e->ignore();
+}
+
+///
+/// \brief AppGridView::relayout rebuild section offsets and fit view height to content
+///
+void AppGridView::relayout()
+{
+    m_sectionTops.clear();
+
+    int top = 0;
+    const int count = m_groupedModel ? m_groupedModel->sectionCount() : 0;
+    m_sectionTops.reserve(count);
+    for (int i(0); i != count; ++i)
+    {
+        m_sectionTops.append(top);
+        top += sectionHeight(i);
+    }
+
+    setFixedHeight(top);
+    viewport()->update();
+}
+
+///
+/// \brief AppGridView::sectionAt binary search section by y offset
+/// \return section index, or -1 if y is out of range
+///
+int AppGridView::sectionAt(const int y) const
+{
+    if (m_sectionTops.isEmpty() || y < 0 || y >= height())
+        return -1;
+
+    return std::upper_bound(m_sectionTops.cbegin(), m_sectionTops.cend(), y) - m_sectionTops.cbegin() - 1;
+}
+
+int AppGridView::sectionHeight(const int section) const
+{
+    const int column = m_calcUtil->appColumnCount();
+    const int rows = (m_groupedModel->sectionSize(section) + column - 1) / column;
+    const int rowHeight = m_calcUtil->appItemSize().height() + m_calcUtil->appItemSpacing() * 2;
+
+    return DLauncher::CATEGORY_TITLE_WIDGET_HEIGHT + rows * rowHeight;
+}
+
+const QRect AppGridView::sectionTitleRect(const int section) const
+{
+    return QRect(0, m_sectionTops[section], viewport()->width(), DLauncher::CATEGORY_TITLE_WIDGET_HEIGHT);
+}
+
+const QRect AppGridView::sectionItemsRect(const int section) const
+{
+    const int top = m_sectionTops[section] + DLauncher::CATEGORY_TITLE_WIDGET_HEIGHT;
+
+    return QRect(0, top, viewport()->width(), sectionHeight(section) - DLauncher::CATEGORY_TITLE_WIDGET_HEIGHT);
+}
+
+///
+/// \brief AppGridView::itemRect items are placed in grid, spacing is padded around each item
+/// \param section section index
+/// \param pos position of app in this section
+///
+const QRect AppGridView::itemRect(const int section, const int pos) const
+{
+    const QSize itemSize = m_calcUtil->appItemSize();
+    const int spacing = m_calcUtil->appItemSpacing();
+    const int column = m_calcUtil->appColumnCount();
+    const int top = m_sectionTops[section] + DLauncher::CATEGORY_TITLE_WIDGET_HEIGHT;
+
+    const int x = (pos % column) * (itemSize.width() + spacing * 2) + spacing;
+    const int y = top + (pos / column) * (itemSize.height() + spacing * 2) + spacing;
+
+    return QRect(QPoint(x, y), itemSize);
+}
+
+///
+/// \brief AppGridView::paintTitle paint title as CategoryTitleWidget, text with shadow and a white line fade out to right
+///
+void AppGridView::paintTitle(QPainter *painter, const QRect &rect, const QString &title) const
+{
+    QFont titleFont(painter->font());
+    titleFont.setPixelSize(m_calcUtil->titleTextSize());
+    const QFontMetrics fontMetric(titleFont);
+    const QRect textRect(rect.left() + TitleMargin, rect.top(), fontMetric.width(title) + 10, rect.height());
+
+    painter->save();
+
+    if (m_titleOpacity > 0)
+    {
+        painter->setFont(titleFont);
+        painter->setPen(QColor(0, 0, 0, 128 * m_titleOpacity));
+        painter->drawText(textRect.translated(0, 2), Qt::AlignLeft | Qt::AlignVCenter, title);
+        painter->setPen(QColor::fromRgbF(1, 1, 1, m_titleOpacity));
+        painter->drawText(textRect, Qt::AlignLeft | Qt::AlignVCenter, title);
+    }
+
+    const int lineLeft = textRect.right() + TitleSpacing;
+    const int lineRight = rect.right() - TitleMargin;
+    QLinearGradient lineGradient(lineLeft, 0, lineRight, 0);
+    lineGradient.setColorAt(0, QColor::fromRgbF(1, 1, 1, 0.3));
+    lineGradient.setColorAt(1, QColor::fromRgbF(1, 1, 1, 0));
+    painter->fillRect(QRect(lineLeft, rect.center().y(), lineRight - lineLeft, 1), lineGradient);
+
+    painter->restore();
+}
+
+void AppGridView::dragApp(const QModelIndex &index)
+{
+    if (!index.isValid())
+        return;
+
+    const QPixmap pixmap = index.data(AppsListModel::AppIconRole).value<QPixmap>();
+
+    QDrag *drag = new QDrag(this);
+    drag->setMimeData(model()->mimeData(QModelIndexList() << index));
+    drag->setPixmap(pixmap.scaled(DLauncher::APP_DRAG_ICON_SIZE, DLauncher::APP_DRAG_ICON_SIZE, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    drag->setHotSpot(QPoint(DLauncher::APP_DRAG_ICON_SIZE, DLauncher::APP_DRAG_ICON_SIZE) / 2);
+
+    drag->exec(Qt::MoveAction);
+}
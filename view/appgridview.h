@@ -0,0 +1,87 @@
+#ifndef APPGRIDVIEW_H
+#define APPGRIDVIEW_H
+
+#include <QAbstractItemView>
+#include <QVector>
+
+#include "model/appslistmodel.h"
+
+class CalculateUtil;
+class GroupedAppsModel;
+class QPropertyAnimation;
+
+///
+/// \brief The AppGridView class shows apps of all categories in one view, category titles are painted as section title rows
+///
+/// item positions are calculated from section offsets and grid size, nothing is
+/// stored per item. the view is resized to fit its content and placed in a
+/// scroll area, only items intersect the exposed rect are painted.
+///
+class AppGridView : public QAbstractItemView
+{
+    Q_OBJECT
+    Q_PROPERTY(qreal titleOpacity READ titleOpacity WRITE setTitleOpacity)
+
+public:
+    explicit AppGridView(QWidget *parent = 0);
+
+    void setModel(QAbstractItemModel *model) Q_DECL_OVERRIDE;
+    QRect visualRect(const QModelIndex &index) const Q_DECL_OVERRIDE;
+    void scrollTo(const QModelIndex &index, ScrollHint hint = EnsureVisible) Q_DECL_OVERRIDE;
+    QModelIndex indexAt(const QPoint &point) const Q_DECL_OVERRIDE;
+
+    const QModelIndex moveIndex(const QModelIndex &index, const CursorAction action) const;
+    int indexYOffset(const QModelIndex &index) const;
+    AppsListModel::AppCategory categoryAt(const int y) const;
+    const QRect titleRect(const AppsListModel::AppCategory category) const;
+    const QRect categoryRect(const AppsListModel::AppCategory category) const;
+
+    qreal titleOpacity() const;
+    void setTitleOpacity(const qreal titleOpacity);
+
+public slots:
+    void setTitleVisible(const bool visible, const bool animation = false);
+
+signals:
+    void popupMenuRequested(const QPoint &pos, const QModelIndex &index) const;
+
+protected:
+    QModelIndex moveCursor(CursorAction cursorAction, Qt::KeyboardModifiers modifiers) Q_DECL_OVERRIDE;
+    int horizontalOffset() const Q_DECL_OVERRIDE;
+    int verticalOffset() const Q_DECL_OVERRIDE;
+    bool isIndexHidden(const QModelIndex &index) const Q_DECL_OVERRIDE;
+    void setSelection(const QRect &rect, QItemSelectionModel::SelectionFlags command) Q_DECL_OVERRIDE;
+    QRegion visualRegionForSelection(const QItemSelection &selection) const Q_DECL_OVERRIDE;
+    void paintEvent(QPaintEvent *e) Q_DECL_OVERRIDE;
+    void mousePressEvent(QMouseEvent *e) Q_DECL_OVERRIDE;
+    void mouseMoveEvent(QMouseEvent *e) Q_DECL_OVERRIDE;
+    void mouseReleaseEvent(QMouseEvent *e) Q_DECL_OVERRIDE;
+    void wheelEvent(QWheelEvent *e) Q_DECL_OVERRIDE;
+
+private slots:
+    void relayout();
+
+private:
+    int sectionAt(const int y) const;
+    int sectionHeight(const int section) const;
+    const QRect sectionTitleRect(const int section) const;
+    const QRect sectionItemsRect(const int section) const;
+    const QRect itemRect(const int section, const int pos) const;
+    void paintTitle(QPainter *painter, const QRect &rect, const QString &title) const;
+    void dragApp(const QModelIndex &index);
+
+private:
+    CalculateUtil *m_calcUtil;
+    GroupedAppsModel *m_groupedModel = nullptr;
+
+    QPropertyAnimation *m_opacityAnimation;
+    qreal m_titleOpacity = 1;
+
+    QPoint m_dragStartPos;
+
+    // y offset of each section, same order as model sections, section ends at the next one.
+    // rebuilt when model or item size is changed
+    QVector<int> m_sectionTops;
+};
+
+#endif // APPGRIDVIEW_H
@@ -10,12 +10,15 @@
 #include <QPainter>
 #include <QDebug>
 #include <QLinearGradient>
+#include <QImage>
 
 #include "gradientlabel.h"
 
 GradientLabel::GradientLabel(QWidget *parent) :
     QLabel(parent),
-    m_direction(GradientLabel::TopToBottom)
+    m_direction(GradientLabel::TopToBottom),
+    m_composedKey(0),
+    m_composedDirection(GradientLabel::TopToBottom)
 {
     setAttribute(Qt::WA_TransparentForMouseEvents);
 }
@@ -28,6 +31,7 @@ GradientLabel::Direction GradientLabel::direction() const
 void GradientLabel::setDirection(const GradientLabel::Direction &direction)
 {
     m_direction = direction;
+    update();
 }
 
 void setText(const QString &)
@@ -44,9 +48,34 @@ void GradientLabel::paintEvent(QPaintEvent*)
 
 //    painter.end();
 
-    // process the pixmap
+    updateComposed();
+
+    // draw the pixmap
+    QPainter painter;
+    painter.begin(this);
+
+    painter.drawPixmap(0, 0, m_composed);
+
+    painter.end();
+}
+
+void GradientLabel::updateComposed()
+{
     const QPixmap *thisPix = pixmap();
-    QPixmap pix(thisPix->rect().size());
+    if (!thisPix || thisPix->isNull()) {
+        m_composed = QPixmap();
+        m_composedKey = 0;
+        return;
+    }
+
+    if (m_composedKey == thisPix->cacheKey() && m_composedDirection == m_direction)
+        return;
+
+    m_composedKey = thisPix->cacheKey();
+    m_composedDirection = m_direction;
+
+    // process the pixmap
+    QImage pix(thisPix->size(), QImage::Format_ARGB32_Premultiplied);
     pix.fill(Qt::transparent);
 
     QPainter pixPainter;
@@ -70,11 +99,5 @@ void GradientLabel::paintEvent(QPaintEvent*)
 
     pixPainter.end();
 
-    // draw the pixmap
-    QPainter painter;
-    painter.begin(this);
-
-    painter.drawPixmap(0, 0, pix);
-
-    painter.end();
+    m_composed = QPixmap::fromImage(pix);
 }
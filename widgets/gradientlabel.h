@@ -32,7 +32,13 @@ public:
 private:
     Direction m_direction;
 
+    // source pixmap with gradient applied, rebuilt when source or direction is changed
+    QPixmap m_composed;
+    qint64 m_composedKey;
+    Direction m_composedDirection;
+
     void paintEvent(QPaintEvent* event);
+    void updateComposed();
 };
 
 #endif // GRADIENTLABEL_H